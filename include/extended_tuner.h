@@ -89,6 +89,15 @@ public:
     template <typename T> void addArgumentOutputReference(const std::vector<T>& source);
     template <typename T> void addArgumentScalarReference(const T argument);
 
+    // Uploads a named buffer once, which can then be bound as an argument to any kernel (including the reference) without another copy.
+    // A buffer is freed once it is released and no kernel uses it anymore.
+    template <typename T> void addSharedBuffer(const std::string& name, const std::vector<T>& source);
+    void PUBLIC_API releaseSharedBuffer(const std::string& name);
+    void PUBLIC_API addArgumentInputShared(const size_t id, const std::string& name);
+    void PUBLIC_API addArgumentOutputShared(const size_t id, const std::string& name);
+    void PUBLIC_API addArgumentInputSharedReference(const std::string& name);
+    void PUBLIC_API addArgumentOutputSharedReference(const std::string& name);
+
     // ==============================================================================================================================================
     // Additional settings methods
 
@@ -0,0 +1,65 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the BackgroundLoad class, which keeps host threads busy for as long as it
+// exists, to measure kernels under concurrent load (see SetBackgroundLoad). Each thread repeatedly
+// streams through its own buffer, which is larger than typical last-level caches, such that the
+// load competes for both the cores and the memory bandwidth.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_BACKGROUND_LOAD_H_
+#define CLTUNE_BACKGROUND_LOAD_H_
+
+#include <vector> // std::vector
+#include <thread> // std::thread
+#include <atomic> // std::atomic
+
+namespace cltune {
+// =================================================================================================
+
+// See comment at top of file for a description of the class
+class BackgroundLoad {
+ public:
+
+  // The size of the buffer of each thread
+  static constexpr auto kBufferSize = size_t{64 * 1024 * 1024};
+
+  // Starts the threads, which run until destruction
+  explicit BackgroundLoad(const size_t num_threads);
+  ~BackgroundLoad();
+
+  // The load is neither copyable nor movable
+  BackgroundLoad(const BackgroundLoad&) = delete;
+  BackgroundLoad& operator=(const BackgroundLoad&) = delete;
+
+ private:
+  std::atomic<bool> stop_;
+  std::vector<std::thread> threads_;
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_BACKGROUND_LOAD_H_
+#endif
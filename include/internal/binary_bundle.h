@@ -0,0 +1,111 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the BinaryBundle class, a single file with the compiled programs of the best
+// configurations of kernels (see SaveBinaryBundle). Applications load the programs from a bundle at
+// startup instead of compiling their kernels from source. Each program is indexed by its kernel,
+// device, and driver version, and is stored together with its (configured) source: programs for a
+// different driver, and binaries rejected by the driver, are compiled from this source instead.
+//
+// A bundle file consists of a header of 64-bit integers (magic number, number of programs, and
+// the offset and size of each field of each program), followed by the fields. The fields start at
+// multiples of kAlignment bytes, such that the binaries can be used directly when mapped.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_BINARY_BUNDLE_H_
+#define CLTUNE_BINARY_BUNDLE_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <map> // std::map
+#include <memory> // std::unique_ptr
+
+#include "internal/mapped_file.h"
+
+// Host data-structures for the device programs
+#if USE_OPENCL
+  #include "internal/clpp11.h"
+#else
+  #include "internal/cupp11.h"
+#endif
+
+namespace cltune {
+// =================================================================================================
+
+// A program of a bundle
+struct BundleEntry {
+  std::string kernel;
+  std::string device;
+  std::string driver; // The driver version, see Device::DriverVersion
+  std::string source; // The kernel source including the defines of its configuration
+  std::string binary; // The output of Program::GetIR
+};
+
+// See comment at top of file for a description of the class
+class BinaryBundle {
+ public:
+
+  // Alignment (in bytes) of the fields in a bundle file
+  static constexpr auto kAlignment = size_t{64};
+
+  // Maps a bundle file into memory. Throws if the file cannot be opened or is not a bundle.
+  explicit BinaryBundle(const std::string &filename);
+
+  // The bundle is memory-mapped: it is neither copyable nor movable
+  BinaryBundle(const BinaryBundle&) = delete;
+  BinaryBundle& operator=(const BinaryBundle&) = delete;
+
+  // Returns the programs in the bundle (copied out of the mapping)
+  std::vector<BundleEntry> Entries() const;
+
+  // Builds the programs of all kernels in the bundle for a device, in parallel. Programs are
+  // created from their binary if the bundle holds one for this device and driver, and compiled
+  // from their source if the driver rejects it or if there is only one for another driver. Kernels
+  // without a program for this device are left out. Throws if a source fails to compile.
+  std::map<std::string, Program> Load(const Context &context, const Device &device) const;
+
+  // Writes a bundle file. The file is written under a temporary name first, such that other
+  // processes never see a partially written file.
+  static void Save(const std::string &filename, const std::vector<BundleEntry> &entries);
+
+ private:
+
+  // The location of a field within the mapped file, and its contents as a string
+  struct Field {
+    size_t offset;
+    size_t size;
+  };
+  std::string Read(const Field &field) const;
+
+  static constexpr auto kNumFields = size_t{5}; // Kernel, device, driver, source, and binary
+
+  std::unique_ptr<MappedFile> file_;
+  std::vector<std::vector<Field>> index_; // The fields of each program
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_BINARY_BUNDLE_H_
+#endif
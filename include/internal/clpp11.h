@@ -42,6 +42,7 @@
 #include <memory>    // std::shared_ptr
 #include <stdexcept> // std::runtime_error
 #include <numeric>   // std::accumulate
+#include <mutex>     // std::mutex, std::lock_guard
 
 // OpenCL
 #if defined(__APPLE__) || defined(__MACOSX)
@@ -91,6 +92,14 @@ class Event {
     CheckError(clWaitForEvents(1, &(*event_)));
   }
 
+  // Returns whether the event has completed without waiting. Errors also count as completed, these
+  // are reported when waiting for the event.
+  bool IsCompleted() const {
+    auto status = cl_int{CL_COMPLETE};
+    clGetEventInfo(*event_, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status), &status, nullptr);
+    return status <= CL_COMPLETE;
+  }
+
   // Retrieves the elapsed time of the last recorded event. Note that no error checking is done on
   // the 'clGetEventProfilingInfo' function, since there is a bug in Apple's OpenCL implementation:
   // http://stackoverflow.com/questions/26145603/clgeteventprofilinginfo-bug-in-macosx
@@ -104,6 +113,21 @@ class Event {
     return static_cast<float>(time_end - time_start) * 1.0e-6f;
   }
 
+  // As above, but retrieves all profiling timestamps (in ns): queued, submitted, started, and ended
+  std::vector<unsigned long long> GetTimestamps() const {
+    WaitForCompletion();
+    const auto bytes = sizeof(cl_ulong);
+    const cl_profiling_info queries[] = {CL_PROFILING_COMMAND_QUEUED, CL_PROFILING_COMMAND_SUBMIT,
+                                         CL_PROFILING_COMMAND_START, CL_PROFILING_COMMAND_END};
+    auto result = std::vector<unsigned long long>();
+    for (auto query: queries) {
+      auto timestamp = cl_ulong{0};
+      clGetEventProfilingInfo(*event_, query, bytes, &timestamp, nullptr);
+      result.push_back(static_cast<unsigned long long>(timestamp));
+    }
+    return result;
+  }
+
   // Accessor to the private data-member
   cl_event& operator()() { return *event_; }
   const cl_event& operator()() const { return *event_; }
@@ -191,6 +215,7 @@ class Device {
     size_t version = (size_t) (100.0 * std::stod(version_string.substr(0, next_whitespace)));
     return version;
   }
+  std::string DriverVersion() const { return GetInfoString(CL_DRIVER_VERSION); }
   std::string Vendor() const { return GetInfoString(CL_DEVICE_VENDOR); }
   std::string Name() const { return GetInfoString(CL_DEVICE_NAME); }
   std::string Type() const {
@@ -287,19 +312,59 @@ class Device {
 
 // =================================================================================================
 
+// Accounting of the device memory allocated by the buffers of a context, in bytes. The peak can be
+// reset, e.g. to measure the usage during a single kernel run.
+class MemoryUsage {
+ public:
+  explicit MemoryUsage(): mutex_(), current_(0), peak_(0) { }
+
+  // Registers an allocation or a release
+  void Allocate(const size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ += bytes;
+    peak_ = std::max(peak_, current_);
+  }
+  void Free(const size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ -= std::min(bytes, current_);
+  }
+
+  // Resets the peak to the current usage
+  void ResetPeak() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peak_ = current_;
+  }
+
+  // Accessors to the current and the peak usage
+  size_t Current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+  }
+  size_t Peak() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_;
+  }
+ private:
+  mutable std::mutex mutex_;
+  size_t current_;
+  size_t peak_;
+};
+
 // C++11 version of 'cl_context'
 class Context {
  public:
 
   // Constructor based on the regular OpenCL data-type: memory management is handled elsewhere
   explicit Context(const cl_context context):
-      context_(new cl_context) {
+      context_(new cl_context),
+      memory_usage_(std::make_shared<MemoryUsage>()) {
     *context_ = context;
   }
 
   // Regular constructor with memory management
   explicit Context(const Device &device):
-      context_(new cl_context, [](cl_context* c) { CheckError(clReleaseContext(*c)); delete c; }) {
+      context_(new cl_context, [](cl_context* c) { CheckError(clReleaseContext(*c)); delete c; }),
+      memory_usage_(std::make_shared<MemoryUsage>()) {
     auto status = CL_SUCCESS;
     const cl_device_id dev = device();
     *context_ = clCreateContext(nullptr, 1, &dev, nullptr, nullptr, &status);
@@ -309,8 +374,12 @@ class Context {
   // Accessor to the private data-member
   const cl_context& operator()() const { return *context_; }
   cl_context* pointer() const { return &(*context_); }
+
+  // The device memory allocated by the buffers of this context
+  const std::shared_ptr<MemoryUsage>& memory_usage() const { return memory_usage_; }
  private:
   std::shared_ptr<cl_context> context_;
+  std::shared_ptr<MemoryUsage> memory_usage_;
 };
 
 // Pointer to an OpenCL context
@@ -443,6 +512,16 @@ class Queue {
     CheckError(clFinish(*queue_));
   }
 
+  // Submits all enqueued commands to the device without waiting for them
+  void Flush() const {
+    CheckError(clFlush(*queue_));
+  }
+
+  // Enqueues a marker: the event completes when all previously enqueued commands have completed
+  void Marker(Event &event) const {
+    CheckError(clEnqueueMarkerWithWaitList(*queue_, 0, nullptr, event.pointer()));
+  }
+
   // Retrieves the corresponding context or device
   Context GetContext() const {
     auto bytes = size_t{0};
@@ -499,6 +578,31 @@ class BufferHost {
 // Enumeration of buffer access types
 enum class BufferAccess { kReadOnly, kWriteOnly, kReadWrite, kNotOwned };
 
+// Enumeration of buffer memory locations: device memory or device-accessible host memory
+enum class BufferMemory { kDevice, kHost };
+
+// Enumeration of host mapping types
+enum class BufferMapping { kRead, kWrite };
+
+// Accounts for the memory of a new buffer in its context until OpenCL destroys the buffer, regardless
+// of how it is released. OpenCL might call the callback from one of its own threads.
+using MemoryAllocation = std::pair<std::shared_ptr<MemoryUsage>, size_t>;
+inline void CL_CALLBACK FreeMemoryAllocation(cl_mem, void* allocation) {
+  auto memory_allocation = static_cast<MemoryAllocation*>(allocation);
+  memory_allocation->first->Free(memory_allocation->second);
+  delete memory_allocation;
+}
+inline void TrackMemoryAllocation(const Context &context, const cl_mem buffer, const size_t bytes) {
+  context.memory_usage()->Allocate(bytes);
+  auto allocation = new MemoryAllocation(context.memory_usage(), bytes);
+  CheckError(clSetMemObjectDestructorCallback(buffer, FreeMemoryAllocation, allocation));
+}
+
+// Releases a buffer which is not owned by a Buffer object
+inline void FreeBuffer(const cl_mem buffer) {
+  CheckError(clReleaseMemObject(buffer));
+}
+
 // C++11 version of 'cl_mem'
 template <typename T>
 class Buffer {
@@ -512,8 +616,10 @@ class Buffer {
   }
 
   // Regular constructor with memory management. If this class does not own the buffer object, then
-  // the memory will not be freed automatically afterwards.
-  explicit Buffer(const Context &context, const BufferAccess access, const size_t size):
+  // the memory will not be freed automatically afterwards. Buffers in host memory are accessed by
+  // the device directly, which avoids copies on devices sharing the host memory (e.g. CPUs).
+  explicit Buffer(const Context &context, const BufferAccess access, const size_t size,
+                  const BufferMemory memory = BufferMemory::kDevice):
       buffer_(new cl_mem, [access](cl_mem* m) {
         if (access != BufferAccess::kNotOwned) { CheckError(clReleaseMemObject(*m)); }
         delete m;
@@ -522,9 +628,11 @@ class Buffer {
     auto flags = cl_mem_flags{CL_MEM_READ_WRITE};
     if (access_ == BufferAccess::kReadOnly) { flags = CL_MEM_READ_ONLY; }
     if (access_ == BufferAccess::kWriteOnly) { flags = CL_MEM_WRITE_ONLY; }
+    if (memory == BufferMemory::kHost) { flags |= CL_MEM_ALLOC_HOST_PTR; }
     auto status = CL_SUCCESS;
     *buffer_ = clCreateBuffer(context(), flags, size*sizeof(T), nullptr, &status);
     CheckError(status);
+    TrackMemoryAllocation(context, *buffer_, size*sizeof(T));
   }
 
   // As above, but now with read/write access as a default
@@ -560,6 +668,36 @@ class Buffer {
     ReadAsync(queue, size, host.data(), offset);
   }
 
+  // Maps a part of the buffer into host memory (blocking) for reading or writing. The pointer is
+  // valid until it is unmapped again. No data is copied for buffers in host memory.
+  T* Map(const Queue &queue, const BufferMapping mapping, const size_t size,
+         const size_t offset = 0) const {
+    auto flags = (mapping == BufferMapping::kRead) ? cl_map_flags{CL_MAP_READ} :
+                                                     cl_map_flags{CL_MAP_WRITE};
+    auto status = CL_SUCCESS;
+    auto host = clEnqueueMapBuffer(queue(), *buffer_, CL_TRUE, flags, offset*sizeof(T),
+                                   size*sizeof(T), 0, nullptr, nullptr, &status);
+    CheckError(status);
+    return static_cast<T*>(host);
+  }
+  void Unmap(const Queue &queue, T* host) const {
+    CheckError(clEnqueueUnmapMemObject(queue(), *buffer_, host, 0, nullptr, nullptr));
+    queue.Finish();
+  }
+
+  // Copies 'num_chunks' chunks of 'chunk_size' elements, 'stride' elements apart and starting at
+  // 'offset', from device to host a-synchronously. The chunks are stored contiguously on the host.
+  void ReadStridedAsync(const Queue &queue, const size_t chunk_size, const size_t num_chunks,
+                        const size_t stride, T* host, const size_t offset = 0) const {
+    if (access_ == BufferAccess::kWriteOnly) { Error("reading from a write-only buffer"); }
+    const size_t buffer_origin[] = {offset*sizeof(T), 0, 0};
+    const size_t host_origin[] = {0, 0, 0};
+    const size_t region[] = {chunk_size*sizeof(T), num_chunks, 1};
+    CheckError(clEnqueueReadBufferRect(queue(), *buffer_, CL_FALSE, buffer_origin, host_origin,
+                                       region, stride*sizeof(T), 0, chunk_size*sizeof(T), 0,
+                                       host, 0, nullptr, nullptr));
+  }
+
   // Copies from device to host: reading the device buffer
   void Read(const Queue &queue, const size_t size, T* host, const size_t offset = 0) const {
     ReadAsync(queue, size, host, offset);
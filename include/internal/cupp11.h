@@ -41,6 +41,8 @@
 #include <vector>    // std::vector
 #include <memory>    // std::shared_ptr
 #include <stdexcept> // std::runtime_error
+#include <map>       // std::map
+#include <mutex>     // std::mutex, std::lock_guard
 
 // CUDA
 #include <cuda.h>    // CUDA driver API
@@ -94,8 +96,15 @@ class Event {
     CheckError(cuEventCreate(end_.get(), CU_EVENT_DEFAULT));
   }
 
-  // Waits for completion of this event (not implemented for CUDA)
-  void WaitForCompletion() const { }
+  // Waits for completion of this event
+  void WaitForCompletion() const {
+    CheckError(cuEventSynchronize(*end_));
+  }
+
+  // Returns whether the event has completed without waiting
+  bool IsCompleted() const {
+    return cuEventQuery(*end_) != CUDA_ERROR_NOT_READY;
+  }
 
   // Retrieves the elapsed time of the last recorded event
   float GetElapsedTime() const {
@@ -104,6 +113,13 @@ class Event {
     return result;
   }
 
+  // As above, but as profiling timestamps (in ns): queued, submitted, started, and ended. CUDA
+  // events only give relative times: the first three are zero and the last is the elapsed time.
+  std::vector<unsigned long long> GetTimestamps() const {
+    auto elapsed = static_cast<unsigned long long>(GetElapsedTime() * 1.0e6f);
+    return std::vector<unsigned long long>{0, 0, 0, elapsed};
+  }
+
   // Accessors to the private data-members
   const CUevent& start() const { return *start_; }
   const CUevent& end() const { return *end_; }
@@ -172,6 +188,7 @@ class Device {
     CheckError(cuDriverGetVersion(&result));
     return static_cast<size_t>(result);
   }
+  std::string DriverVersion() const { return Version(); }
   std::string Vendor() const { return "NVIDIA Corporation"; }
   std::string Name() const {
     auto result = std::string{};
@@ -244,27 +261,71 @@ class Device {
 
 // =================================================================================================
 
+// Accounting of the device memory allocated by the buffers of a context, in bytes. The peak can be
+// reset, e.g. to measure the usage during a single kernel run.
+class MemoryUsage {
+ public:
+  explicit MemoryUsage(): mutex_(), current_(0), peak_(0) { }
+
+  // Registers an allocation or a release
+  void Allocate(const size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ += bytes;
+    peak_ = std::max(peak_, current_);
+  }
+  void Free(const size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ -= std::min(bytes, current_);
+  }
+
+  // Resets the peak to the current usage
+  void ResetPeak() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peak_ = current_;
+  }
+
+  // Accessors to the current and the peak usage
+  size_t Current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+  }
+  size_t Peak() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_;
+  }
+ private:
+  mutable std::mutex mutex_;
+  size_t current_;
+  size_t peak_;
+};
+
 // C++11 version of 'CUcontext'
 class Context {
  public:
 
   // Constructor based on the regular CUDA data-type: memory management is handled elsewhere
   explicit Context(const CUcontext context):
-      context_(new CUcontext) {
+      context_(new CUcontext),
+      memory_usage_(std::make_shared<MemoryUsage>()) {
     *context_ = context;
   }
 
   // Regular constructor with memory management
   explicit Context(const Device &device):
-      context_(new CUcontext, [](CUcontext* c) { CheckError(cuCtxDestroy(*c)); delete c; }) {
+      context_(new CUcontext, [](CUcontext* c) { CheckError(cuCtxDestroy(*c)); delete c; }),
+      memory_usage_(std::make_shared<MemoryUsage>()) {
     CheckError(cuCtxCreate(context_.get(), 0, device()));
   }
 
   // Accessor to the private data-member
   const CUcontext& operator()() const { return *context_; }
   CUcontext* pointer() const { return &(*context_); }
+
+  // The device memory allocated by the buffers of this context
+  const std::shared_ptr<MemoryUsage>& memory_usage() const { return memory_usage_; }
  private:
   std::shared_ptr<CUcontext> context_;
+  std::shared_ptr<MemoryUsage> memory_usage_;
 };
 
 // Pointer to an OpenCL context
@@ -373,6 +434,14 @@ class Queue {
     CheckError(cuStreamSynchronize(*queue_));
   }
 
+  // Submits all enqueued commands to the device without waiting for them (not needed for CUDA)
+  void Flush() const { }
+
+  // Records the end of the event: it completes when all previously enqueued commands have completed
+  void Marker(Event &event) const {
+    CheckError(cuEventRecord(event.end(), *queue_));
+  }
+
   // Retrieves the corresponding context or device
   Context GetContext() const { return context_; }
   Device GetDevice() const { return device_; }
@@ -422,6 +491,42 @@ class BufferHost {
 // Enumeration of buffer access types
 enum class BufferAccess { kReadOnly, kWriteOnly, kReadWrite, kNotOwned };
 
+// Enumeration of buffer memory locations: device memory or device-accessible host memory
+enum class BufferMemory { kDevice, kHost };
+
+// Enumeration of host mapping types
+enum class BufferMapping { kRead, kWrite };
+
+// CUDA has no notification when device memory is freed. Therefore, the allocations are registered
+// by device pointer (unique within a process), and buffers which are not owned by a Buffer object
+// have to be freed through 'FreeBuffer' to be accounted for.
+class MemoryAllocations {
+ public:
+  static void Register(const CUdeviceptr buffer, const std::shared_ptr<MemoryUsage> &usage,
+                       const size_t bytes) {
+    std::lock_guard<std::mutex> lock(Mutex());
+    usage->Allocate(bytes);
+    Allocations()[buffer] = std::make_pair(usage, bytes);
+  }
+  static void Unregister(const CUdeviceptr buffer) {
+    std::lock_guard<std::mutex> lock(Mutex());
+    auto allocation = Allocations().find(buffer);
+    if (allocation == Allocations().end()) { return; }
+    allocation->second.first->Free(allocation->second.second);
+    Allocations().erase(allocation);
+  }
+ private:
+  using AllocationMap = std::map<CUdeviceptr, std::pair<std::shared_ptr<MemoryUsage>, size_t>>;
+  static std::mutex& Mutex() { static std::mutex mutex; return mutex; }
+  static AllocationMap& Allocations() { static AllocationMap allocations; return allocations; }
+};
+
+// Frees a buffer which is not owned by a Buffer object
+inline void FreeBuffer(const CUdeviceptr buffer) {
+  MemoryAllocations::Unregister(buffer);
+  CheckError(cuMemFree(buffer));
+}
+
 // C++11 version of 'CUdeviceptr'
 template <typename T>
 class Buffer {
@@ -430,19 +535,24 @@ class Buffer {
   // Constructor based on the regular CUDA data-type: memory management is handled elsewhere
   explicit Buffer(const CUdeviceptr buffer):
       buffer_(new CUdeviceptr),
-      access_(BufferAccess::kNotOwned) {
+      access_(BufferAccess::kNotOwned),
+      mappings_(new std::vector<Mapping>) {
     *buffer_ = buffer;
   }
 
   // Regular constructor with memory management. If this class does not own the buffer object, then
-  // the memory will not be freed automatically afterwards.
-  explicit Buffer(const Context &, const BufferAccess access, const size_t size):
+  // the memory will not be freed automatically afterwards. CUDA buffers are always allocated in
+  // device memory: the memory location is ignored.
+  explicit Buffer(const Context &context, const BufferAccess access, const size_t size,
+                  const BufferMemory = BufferMemory::kDevice):
       buffer_(new CUdeviceptr, [access](CUdeviceptr* m) {
-        if (access != BufferAccess::kNotOwned) { CheckError(cuMemFree(*m)); }
+        if (access != BufferAccess::kNotOwned) { FreeBuffer(*m); }
         delete m;
       }),
-      access_(access) {
+      access_(access),
+      mappings_(new std::vector<Mapping>) {
     CheckError(cuMemAlloc(buffer_.get(), size*sizeof(T)));
+    MemoryAllocations::Register(*buffer_, context.memory_usage(), size*sizeof(T));
   }
 
   // As above, but now with read/write access as a default
@@ -476,6 +586,52 @@ class Buffer {
     ReadAsync(queue, size, host.data(), offset);
   }
 
+  // Maps a part of the buffer into host memory (blocking) for reading or writing. Since CUDA buffers
+  // are in device memory, this is emulated by a copy into page-locked host memory, which is written
+  // back when unmapping. The pointer has to be unmapped through the same Buffer object.
+  T* Map(const Queue &queue, const BufferMapping mapping, const size_t size,
+         const size_t offset = 0) const {
+    auto host = static_cast<void*>(nullptr);
+    CheckError(cuMemAllocHost(&host, size*sizeof(T)));
+    if (mapping == BufferMapping::kRead) {
+      CheckError(cuMemcpyDtoHAsync(host, *buffer_ + offset*sizeof(T), size*sizeof(T), queue()));
+      queue.Finish();
+    }
+    mappings_->push_back(Mapping{static_cast<T*>(host), size, offset, mapping});
+    return static_cast<T*>(host);
+  }
+  void Unmap(const Queue &queue, T* host) const {
+    for (auto m = mappings_->begin(); m != mappings_->end(); ++m) {
+      if (m->host != host) { continue; }
+      if (m->mapping == BufferMapping::kWrite) {
+        CheckError(cuMemcpyHtoDAsync(*buffer_ + m->offset*sizeof(T), host, m->size*sizeof(T),
+                                     queue()));
+        queue.Finish();
+      }
+      CheckError(cuMemFreeHost(host));
+      mappings_->erase(m);
+      return;
+    }
+    Error("unmapping a pointer which is not mapped");
+  }
+
+  // Copies 'num_chunks' chunks of 'chunk_size' elements, 'stride' elements apart and starting at
+  // 'offset', from device to host a-synchronously. The chunks are stored contiguously on the host.
+  void ReadStridedAsync(const Queue &queue, const size_t chunk_size, const size_t num_chunks,
+                        const size_t stride, T* host, const size_t offset = 0) const {
+    if (access_ == BufferAccess::kWriteOnly) { Error("reading from a write-only buffer"); }
+    auto copy = CUDA_MEMCPY2D{};
+    copy.srcMemoryType = CU_MEMORYTYPE_DEVICE;
+    copy.srcDevice = *buffer_ + offset*sizeof(T);
+    copy.srcPitch = stride*sizeof(T);
+    copy.dstMemoryType = CU_MEMORYTYPE_HOST;
+    copy.dstHost = host;
+    copy.dstPitch = chunk_size*sizeof(T);
+    copy.WidthInBytes = chunk_size*sizeof(T);
+    copy.Height = num_chunks;
+    CheckError(cuMemcpy2DAsync(&copy, queue()));
+  }
+
   // Copies from device to host: reading the device buffer
   void Read(const Queue &queue, const size_t size, T* host, const size_t offset = 0) const {
     ReadAsync(queue, size, host, offset);
@@ -541,6 +697,15 @@ class Buffer {
  private:
   std::shared_ptr<CUdeviceptr> buffer_;
   const BufferAccess access_;
+
+  // Host copies of the currently mapped parts of the buffer
+  struct Mapping {
+    T* host;
+    size_t size;
+    size_t offset;
+    BufferMapping mapping;
+  };
+  std::shared_ptr<std::vector<Mapping>> mappings_;
 };
 
 // =================================================================================================
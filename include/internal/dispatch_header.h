@@ -0,0 +1,76 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the generator of dispatch headers (see PrintDispatchHeader). A dispatch header
+// is a self-contained C++11 header for applications, holding the best configuration of each kernel
+// per device and problem-size class as a constexpr table, together with functions to look up a
+// configuration (at compile-time or at run-time) and to obtain its parameters as defines.
+//
+// Each entry of the table is written on a single line, such that the entries of an existing header
+// can be read back: generating a header again merges the new entries into it.
+//
+// Sweep headers (see PrintSweepHeader) are similar, but hold the intervals of problem sizes of a
+// single kernel from a sweep, with a function selecting the interval of a problem size.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_DISPATCH_HEADER_H_
+#define CLTUNE_DISPATCH_HEADER_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <utility> // std::pair
+
+#include "internal/internal_api.h"
+
+namespace cltune {
+// =================================================================================================
+
+// An entry of a dispatch header: the best configuration of a kernel for a device and a problem-size
+// class, and its execution time (ms)
+struct DispatchEntry {
+  std::string kernel;
+  std::string device;
+  std::string size_class;
+  float time;
+  ParameterRange parameters;
+};
+
+// Adds an entry, replacing an existing entry of the same kernel, device, and problem-size class
+void AddDispatchEntry(std::vector<DispatchEntry> &entries, const DispatchEntry &entry);
+
+// Reads the entries of a previously generated header, or returns none if the file does not exist
+std::vector<DispatchEntry> ReadDispatchHeader(const std::string &filename);
+
+// Generates a header with the given entries. Throws if the file cannot be written.
+void WriteDispatchHeader(const std::string &filename, const std::vector<DispatchEntry> &entries);
+
+// Generates a sweep header for a kernel. Throws if the file cannot be written.
+void WriteSweepHeader(const std::string &filename, const std::string &kernel,
+                      const std::string &device, const std::vector<SweepInterval> &intervals);
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_DISPATCH_HEADER_H_
+#endif
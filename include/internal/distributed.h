@@ -0,0 +1,202 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the classes for distributed tuning. The Coordinator class listens on a TCP or
+// Unix-domain socket and serves batches of configurations to the connected workers. The Worker
+// class connects to a coordinator, receives configurations to run on its own device, and streams
+// back the results. Configurations of workers which are lost (crashed, disconnected, or exceeding
+// the watchdog timeout) are reissued to the others, or marked as failed after too many losses.
+// Local workers which are lost are restarted automatically.
+//
+// Messages are single lines of text:
+//   coordinator -> worker: "RUN <sequence> <kernel id> <num settings> <name> <value> ..."
+//   coordinator -> worker: "DONE"
+//   worker -> coordinator: "HELLO <process id> <device name>"
+//   worker -> coordinator: "RESULT <sequence> <time> <threads> <memory> <timings> <energy> <power>
+//                           <compile time> <local memory> <status> <why>"
+// where the status is 1 for a correct result, 0 for an incorrect or failed one, and 2 for timed-out,
+// 'why' is the failure reason, the memory is the peak device memory usage in bytes, the timings
+// are the time by each of the kNumTimings timing metrics (kernel, submitted, queued, and
+// wall-clock), the energy (J) and power (W) are zero if not measured, the compile time is in ms,
+// and the local memory usage of the kernel is in bytes.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_DISTRIBUTED_H_
+#define CLTUNE_DISTRIBUTED_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <memory> // std::unique_ptr
+#include <chrono> // std::chrono::steady_clock
+
+#include "internal/kernel_info.h"
+
+namespace cltune {
+// =================================================================================================
+
+// Environment variable which turns a tuning program into a worker connecting to the given address
+constexpr auto kWorkerAddressVariable = "CLTUNE_WORKER_ADDRESS";
+
+// The number of timing metrics reported with a result
+constexpr auto kNumTimings = size_t{4};
+
+// Result of a single configuration as reported by a worker
+struct WorkerResult {
+  float time;
+  size_t threads;
+  bool status;
+  std::string failure_reason;
+  bool timed_out;
+  size_t peak_memory;
+  std::vector<float> timings;
+  float energy;
+  float power;
+  float compile_time;
+  size_t local_memory;
+};
+
+// Returns a Unix-domain socket address which is private to this process
+std::string PrivateAddress();
+
+// A single line-based socket connection, used by both the coordinator and the worker
+class Connection {
+ public:
+  explicit Connection(const int socket);
+  ~Connection();
+
+  // Sends a single line. Returns false if the peer is gone.
+  bool SendLine(const std::string &line);
+
+  // Reads all available data from the socket (non-blocking after a poll) and returns the complete
+  // lines. Sets 'closed' when the peer has gone away.
+  std::vector<std::string> ReceiveLines(bool &closed);
+
+  // As above, but blocks until one complete line is available. Returns false if the peer is gone.
+  bool ReceiveLine(std::string &line);
+
+  int socket() const { return socket_; }
+
+ private:
+  int socket_;
+  std::string buffer_;
+  std::vector<std::string> lines_;
+};
+
+// =================================================================================================
+
+// Serves configurations to workers, see the comment at the top of the file
+class Coordinator {
+ public:
+
+  // Time between two checks of the sockets and the local worker processes (in milliseconds)
+  static constexpr auto kPollIntervalMs = 1000;
+
+  // Time the local workers get to exit when the coordinator is done (in milliseconds)
+  static constexpr auto kShutdownTimeoutMs = 5000;
+
+  // Default number of times a configuration can be lost before it is marked as failed
+  static constexpr auto kMaxLosses = size_t{2};
+
+  // Listens on an address of the form "tcp://host:port" or "unix:/path/to/socket"
+  explicit Coordinator(const std::string &address);
+  ~Coordinator();
+
+  // Starts local workers: copies of the current program with the worker address set
+  void SpawnLocalWorkers(const size_t num_workers);
+
+  // Sets the number of times a configuration can be lost before it is marked as failed and the time
+  // a worker gets for a single configuration before it is considered lost (0 for no limit)
+  void SetWatchdog(const size_t max_losses, const float timeout_ms);
+
+  // Runs a batch of configurations of a kernel on the workers and returns the results in the
+  // order of the batch. Blocks until all results are in.
+  std::vector<WorkerResult> Evaluate(const size_t kernel_id,
+                                     const std::vector<KernelInfo::Configuration> &batch);
+
+  // Returns the number of currently connected workers
+  size_t NumWorkers() const { return workers_.size(); }
+
+ private:
+
+  // Per-worker bookkeeping: the connection, the process ID (as reported by the worker), whether it
+  // connected through the private socket of the local workers, and the batch index it currently
+  // works on, including the time at which it started
+  struct WorkerState {
+    std::unique_ptr<Connection> connection;
+    std::string name;
+    int pid;
+    bool local;
+    bool busy;
+    size_t job;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  // Accepts a new worker connection on one of the listening sockets
+  void AcceptWorker(const int listener);
+
+  // Cleans-up after a lost worker and returns the reason. Local workers are killed (in case they
+  // are still hanging) and replaced by a new worker. Only workers which connected through the
+  // private socket are local: the process ID of a remote worker is from another host.
+  std::string DropWorker(const WorkerState &worker);
+
+  // Returns whether any of the spawned local workers is still running
+  bool LocalWorkersAlive();
+
+  std::string address_;
+  int listener_;
+  int local_listener_; // The private socket of the local workers, -1 until they are spawned
+  size_t sequence_;
+  size_t max_losses_;
+  float timeout_ms_;
+  std::vector<WorkerState> workers_;
+  std::vector<int> local_workers_;
+};
+
+// =================================================================================================
+
+// Runs configurations on behalf of a coordinator, see the comment at the top of the file
+class Worker {
+ public:
+
+  // Number of connection attempts (one per second) before giving up on the coordinator
+  static constexpr auto kConnectAttempts = 30;
+
+  // Connects to the coordinator and introduces this worker by its device name
+  explicit Worker(const std::string &address, const std::string &device_name);
+
+  // Waits for the next configuration. Returns false when the coordinator has finished or is gone.
+  bool Receive(size_t &sequence, size_t &kernel_id, KernelInfo::Configuration &configuration);
+
+  // Reports the result of a configuration back to the coordinator
+  void Send(const size_t sequence, const WorkerResult &result);
+
+ private:
+  std::unique_ptr<Connection> connection_;
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_DISTRIBUTED_H_
+#endif
@@ -0,0 +1,92 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the EnergyMeter interface for sources of energy measurements, as well as two
+// implementations: the RaplMeter class reads the energy counters of the processor packages through
+// the Linux powercap interface (RAPL), and the FunctionMeter class calls a user-provided function,
+// such that other sources (e.g. a GPU's management library or an external power meter) can be
+// plugged in.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_ENERGY_METER_H_
+#define CLTUNE_ENERGY_METER_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+#include "internal/internal_api.h"
+
+namespace cltune {
+// =================================================================================================
+
+// See comment at top of file for a description of the class
+class EnergyMeter {
+ public:
+  virtual ~EnergyMeter() { }
+
+  // Returns the energy consumed since an arbitrary point in time, in joules
+  virtual double Read() = 0;
+};
+
+// =================================================================================================
+
+// Sums the counters of all packages. The counters wrap around at their maximum range, which is
+// accounted for as long as they are read at least once per range (minutes at full power).
+class RaplMeter: public EnergyMeter {
+ public:
+
+  // The directory of the powercap interface
+  static const std::string kPowercapDirectory;
+
+  // Finds the package counters, throws if there are none or if they cannot be read
+  RaplMeter();
+
+  virtual double Read() override;
+
+ private:
+  struct Zone {
+    std::string filename; // The 'energy_uj' file
+    double range;         // The maximum value plus one in micro-joules
+    double last;          // The last value read in micro-joules
+    double total;         // The energy since the first read in micro-joules
+  };
+  std::vector<Zone> zones_;
+};
+
+// =================================================================================================
+
+// Calls a function which returns the energy consumed since an arbitrary point in time in joules
+class FunctionMeter: public EnergyMeter {
+ public:
+  explicit FunctionMeter(EnergyFunction function): function_(function) { }
+  virtual double Read() override { return function_(); }
+ private:
+  EnergyFunction function_;
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_ENERGY_METER_H_
+#endif
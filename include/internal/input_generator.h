@@ -0,0 +1,74 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the built-in kernel which fills input buffers with synthetic data on the
+// device (see AddArgumentInputGenerated). The kernel is compiled once per data-type. Random values
+// are computed from the seed and the index of each value by a counter-based generator, such that
+// the contents do not depend on the device, the number of threads, or the order of execution.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_INPUT_GENERATOR_H_
+#define CLTUNE_INPUT_GENERATOR_H_
+
+#include <string> // std::string
+
+#include "internal/kernel_info.h"
+#include "internal/internal_api.h"
+
+namespace cltune {
+// =================================================================================================
+
+// The name of the generator kernel
+const std::string kGeneratorKernelName = "GenerateInput";
+
+// The floating-point type in which the values are computed and the number of values per element
+// (2 for complex numbers). These determine the kernel's scalar arguments for each data-type.
+template <typename T> struct GeneratorTraits {
+  using Real = float;
+  static constexpr size_t kComponents = 1;
+};
+template <> struct GeneratorTraits<double> {
+  using Real = double;
+  static constexpr size_t kComponents = 1;
+};
+template <> struct GeneratorTraits<float2> {
+  using Real = float;
+  static constexpr size_t kComponents = 2;
+};
+template <> struct GeneratorTraits<double2> {
+  using Real = double;
+  static constexpr size_t kComponents = 2;
+};
+
+// Returns the source of the generator kernel (OpenCL or CUDA) for a specific data-type
+std::string GeneratorSource(const MemType type);
+
+// Describes a generator for the reference cache key
+std::string GeneratorDescription(const InputGenerator &generator);
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_INPUT_GENERATOR_H_
+#endif
@@ -34,6 +34,7 @@
 #include <memory> // std::unique_ptr
 #include <functional> // std::function
 #include <utility> // std::pair
+#include <cstdint> // uint64_t
 
 // Exports library functions under Windows when building a DLL. See also:
 // https://msdn.microsoft.com/en-us/library/a90k134d.aspx
@@ -48,6 +49,7 @@ namespace cltune {
 
 // Forward declaration of the implemenation class
 class TunerImpl;
+class Tuner;
 
 // CLTune's custom data-types
 using IntRange = std::vector<size_t>;
@@ -55,6 +57,9 @@ using StringRange = std::vector<std::string>;
 using ParameterRange = std::vector<std::pair<std::string, size_t>>;
 using ConstraintFunction = std::function<bool(std::vector<size_t>)>;
 using LocalMemoryFunction = std::function<size_t(std::vector<size_t>)>;
+using ReferenceFunction = std::function<void(const std::vector<void*>&)>;
+using EnergyFunction = std::function<double()>;
+using SweepFunction = std::function<size_t(Tuner&, const size_t)>;
 
 // Enumeration for search strategies
 enum class SearchMethod{FullSearch, RandomSearch, Annealing, PSO};
@@ -65,6 +70,95 @@ enum class Model { kLinearRegression, kNeuralNetwork };
 // Verification methods
 enum class VerificationMethod { AbsoluteDifference, SideBySide };
 
+// Metrics for the time of a run (see SetTimingMetric). The device metrics follow from the profiling
+// timestamps of the kernel launches and all end when a kernel has finished: kKernel starts when it
+// starts executing (the default), kSubmitted when it is submitted to the device, and kQueued when
+// it is enqueued by the host. kWallClock is the host time from the launch of a kernel until the
+// host has seen its completion, which includes the launch overhead and the synchronization.
+enum class TimingMetric { kKernel, kSubmitted, kQueued, kWallClock };
+
+// Statistics over the runs of a configuration (see SetRunStatistic): the minimum (the default), the
+// mean, a percentile, the mean plus a multiple of the standard deviation, or the maximum
+enum class RunStatistic { kMinimum, kMean, kPercentile, kMeanPlusStdDev, kMaximum };
+
+// What to do when the drift sentinel finds the baseline configuration slower or faster than at
+// the start (see SetDriftSentinel): normalize the times of the following configurations by the
+// drift, or pause until the baseline has recovered and re-measure the configurations since the
+// previous check
+enum class DriftAction { kNormalize, kRemeasure };
+
+// Objectives of a run (see SetObjective), lower is better: its time (as selected with
+// SetTimingMetric, in ms), its energy (J), the product of both (the energy-delay product), the time
+// to compile the kernel (ms), the local memory used by the kernel (bytes), and the peak device
+// memory allocated by the tuner (bytes)
+enum class Objective { kTime, kEnergy, kEnergyDelay, kCompileTime, kLocalMemory, kDeviceMemory };
+
+// The time of a run (in ms) by each of the timing metrics, and the profiling timestamps (in ns, on
+// the device clock) of the first kernel launch and of the end of the last
+struct RunTimings {
+  float kernel;
+  float submitted;
+  float queued;
+  float wall_clock;
+  uint64_t queued_ns;
+  uint64_t submitted_ns;
+  uint64_t start_ns;
+  uint64_t end_ns;
+  float Get(const TimingMetric metric) const {
+    switch (metric) {
+      case TimingMetric::kSubmitted: return submitted;
+      case TimingMetric::kQueued: return queued;
+      case TimingMetric::kWallClock: return wall_clock;
+      default: return kernel;
+    }
+  }
+};
+
+// Hardware counters of a run (see UseHardwareCounters): the counts per launch, summed over the
+// iterations of the run, for all threads of the process. All zero when not collected.
+struct HardwareCounters {
+  uint64_t cycles;
+  uint64_t instructions;
+  uint64_t llc_misses; // Last-level cache misses
+  uint64_t branch_misses;
+  uint64_t vector_instructions; // Only with a processor-specific event, see UseHardwareCounters
+};
+
+// Synthetic input data, generated on the device (see AddArgumentInputGenerated). The meaning of the
+// parameters depends on the distribution, use the functions below to create a generator. Random
+// values depend only on the seed and their index. Integer data-types are rounded down.
+enum class Distribution { kUniform, kNormal, kConstant, kIota, kSparse };
+struct InputGenerator {
+  Distribution distribution;
+  double first;   // Minimum (uniform, sparse), mean (normal), value (constant), or start (iota)
+  double second;  // Maximum (uniform, sparse), standard deviation (normal), or step (iota)
+  double density; // Fraction of non-zero elements (sparse)
+  uint64_t seed;
+
+  // Uniformly distributed values in [minimum, maximum)
+  static InputGenerator Uniform(const double minimum, const double maximum, const uint64_t seed) {
+    return InputGenerator{Distribution::kUniform, minimum, maximum, 1.0, seed};
+  }
+  // Normally distributed values
+  static InputGenerator Normal(const double mean, const double deviation, const uint64_t seed) {
+    return InputGenerator{Distribution::kNormal, mean, deviation, 1.0, seed};
+  }
+  // All values equal
+  static InputGenerator Constant(const double value) {
+    return InputGenerator{Distribution::kConstant, value, 0.0, 1.0, 0};
+  }
+  // The sequence start, start + step, start + 2 * step, ... (the real part only for complex types)
+  static InputGenerator Iota(const double start, const double step) {
+    return InputGenerator{Distribution::kIota, start, step, 1.0, 0};
+  }
+  // A randomly chosen fraction 'density' of the elements is uniform in [minimum, maximum), the
+  // others are zero
+  static InputGenerator Sparse(const double density, const double minimum, const double maximum,
+                               const uint64_t seed) {
+    return InputGenerator{Distribution::kSparse, minimum, maximum, density, seed};
+  }
+};
+
 // Structure that holds results of a tuning run
 struct PublicTunerResult {
   std::string kernel_name;
@@ -72,6 +166,32 @@ struct PublicTunerResult {
   size_t threads;
   bool status;
   ParameterRange parameter_values;
+  std::string failure_reason;
+  double confidence; // Probability that the verification detects an incorrect output
+  size_t peak_memory; // Peak device memory allocated by the tuner during the run (bytes)
+  RunTimings timings; // The time by each metric: 'time' is the one selected with SetTimingMetric
+  HardwareCounters counters; // Hardware counters, if enabled with UseHardwareCounters
+  float energy; // Energy per launch, summed over the iterations (J), if measured
+  float power; // Average power during the launches (W), if measured
+  float compile_time; // Time to compile the kernel (ms)
+  size_t local_memory; // Local memory used by the kernel (bytes)
+  std::vector<float> run_times; // The time of each run by the timing metric (see SetNumRuns)
+  float drift; // Time of the baseline relative to its initial time (see SetDriftSentinel)
+};
+
+// A range of problem sizes (inclusive) and their best configuration, from a sweep (see TuneSweep)
+struct SweepInterval {
+  size_t min_size;
+  size_t max_size;
+  ParameterRange configuration;
+};
+
+// A drift of the baseline beyond the tolerance, found after 'configuration' configurations
+struct DriftEvent {
+  std::string kernel_name;
+  size_t configuration;
+  float drift; // Time of the baseline relative to its initial time
+  size_t num_remeasured; // Configurations measured again (with DriftAction::kRemeasure)
 };
 
 // The tuner class and its public API
@@ -99,6 +219,14 @@ class Tuner {
                                          const std::string &kernel_name,
                                          const IntRange &global, const IntRange &local);
 
+  // Sets a host function as the reference instead of a kernel. The function is given one host buffer
+  // per output argument of the (first) kernel to tune, in order, holding the initial contents of
+  // that output. It should fill these with the expected results, computed from its own copy of the
+  // inputs. The function runs on a separate host thread, concurrently with the first kernel runs:
+  // only their verification waits for it. Calling this function again or setting a reference kernel
+  // will overwrite the previous reference.
+  void PUBLIC_API SetReferenceFunction(ReferenceFunction function);
+
   // Adds a new tuning parameter for a kernel with a specific ID. The parameter has a name, the
   // number of values, and a list of values.
   void PUBLIC_API AddParameter(const size_t id, const std::string &parameter_name,
@@ -119,6 +247,13 @@ class Tuner {
   // it to become part of the tuning process. Single run kernels do not need to use this method.
   void PUBLIC_API SetMultirunKernelIterations(const size_t id, const std::string &parameter_name);
 
+  // Sets the tuning parameters for a streamed kernel (see AddArgumentInputStreamed): the number of
+  // equal chunks its streamed arguments are split into, and the number of chunks in flight. Each
+  // chunk in flight has its own queue, such that its uploads, kernel, and downloads overlap with
+  // those of the others. Without these parameters a streamed kernel runs as a single chunk.
+  void PUBLIC_API SetStreamingParameters(const size_t id, const std::string &chunks_parameter,
+                                         const std::string &in_flight_parameter);
+
   // Adds a new constraint to the set of parameters (e.g. must be equal or larger than). The
   // constraints come in the form of a function object which takes a number of tuning parameters,
   // given as a vector of strings (parameter names). Their names are later substituted by actual
@@ -131,6 +266,64 @@ class Tuner {
   void PUBLIC_API SetLocalMemoryUsage(const size_t id, LocalMemoryFunction amount,
                                       const std::vector<std::string> &parameters);
 
+  // Allocates the buffers of subsequently added arguments in host memory which the device accesses
+  // directly (zero-copy), filling and reading them through mappings instead of copies. This saves
+  // memory and copies on devices which share the host memory. By default, this is enabled for CPU
+  // devices only.
+  void PUBLIC_API UseZeroCopyBuffers(const bool enabled);
+
+  // Limits the device memory the tuner may allocate to 'bytes' (0 for the device's memory size). A
+  // configuration is rejected without running it if the copies of its output buffers would exceed
+  // the budget. The peak device memory usage is reported with each result.
+  void PUBLIC_API SetDeviceMemoryBudget(const size_t bytes);
+
+  // Selects the metric for the time of a run, which is reported as the time of the results and is
+  // optimized by the searchers. All metrics are recorded with each result regardless.
+  void PUBLIC_API SetTimingMetric(const TimingMetric metric);
+
+  // Runs each configuration 'num_runs' times and reports a statistic over these runs as its time,
+  // e.g. the 99th percentile (parameter 99) or the mean plus 3 standard deviations (parameter 3)
+  // rather than the minimum. The time of each run is stored with the results.
+  void PUBLIC_API SetNumRuns(const size_t num_runs);
+  void PUBLIC_API SetRunStatistic(const RunStatistic statistic, const double parameter);
+
+  // Keeps 'num_threads' host threads busy during the runs, to measure under concurrent load
+  void PUBLIC_API SetBackgroundLoad(const size_t num_threads);
+
+  // Re-runs the baseline configuration of a kernel before tuning and every 'interval'
+  // configurations, to detect drift of more than 'tolerance' (relative) in its time, e.g. due to
+  // thermal throttling. The drift events are printed, stored with the results, and returned by
+  // GetDriftEvents.
+  void PUBLIC_API SetDriftSentinel(const size_t id, const ParameterRange &baseline,
+                                   const size_t interval, const double tolerance,
+                                   const DriftAction action);
+  std::vector<DriftEvent> PUBLIC_API GetDriftEvents() const;
+
+  // Counts hardware events during the timed launches with Linux perf_event, meant for CPU devices
+  // on which the kernels run on host threads. Vector instructions are counted with the raw event
+  // code 'vector_event', which is processor-specific (0 to skip them). Throws if the counters are
+  // not available.
+  void PUBLIC_API UseHardwareCounters(const bool enabled, const uint64_t vector_event);
+
+  // Measures the energy of the launches of each run. The first reads the processor packages' energy
+  // counters through Linux powercap (RAPL) and throws if they are not available. The second uses a
+  // function returning the energy consumed so far in joules, e.g. from another source.
+  void PUBLIC_API UseEnergyMeasurement(const bool enabled);
+  void PUBLIC_API SetEnergyFunction(EnergyFunction function);
+
+  // Selects what the searchers minimize: a single objective or a weighted sum of objectives. The
+  // energy objectives require energy measurement.
+  void PUBLIC_API SetObjective(const Objective objective);
+  void PUBLIC_API SetObjectiveWeights(const std::vector<std::pair<Objective,double>> &weights);
+
+  // Rejects configurations of which an objective exceeds 'maximum', e.g. "fastest with a
+  // compilation time under 2 seconds". Rejected configurations are reported as failures.
+  void PUBLIC_API AddObjectiveConstraint(const Objective objective, const double maximum);
+
+  // Keeps track of the Pareto front of the given objectives: the configurations which are not
+  // outperformed in all of these objectives by any other. The front is printed with the results.
+  void PUBLIC_API SetParetoObjectives(const std::vector<Objective> &objectives);
+
   // Functions to add kernel-arguments for input buffers, output buffers, and scalars. Make sure to
   // call these in the order in which the arguments appear in the kernel.
   template <typename T> void AddArgumentInput(const size_t id, const std::vector<T> &source);
@@ -142,6 +335,45 @@ class Tuner {
   template <typename T> void AddArgumentOutputReference(const std::vector<T> &source);
   template <typename T> void AddArgumentScalarReference(const T argument);
 
+  // As AddArgumentInput, but the data is read from 'num_bytes' bytes of a binary file starting at
+  // byte 'offset' (0 bytes for the remainder of the file). The file is memory-mapped and streamed to
+  // the device in chunks, such that it does not have to fit in host memory.
+  template <typename T> void AddArgumentInputFromFile(const size_t id, const std::string &filename,
+                                                      const size_t offset = 0,
+                                                      const size_t num_bytes = 0);
+  template <typename T> void AddArgumentInputFromFileReference(const std::string &filename,
+                                                               const size_t offset = 0,
+                                                               const size_t num_bytes = 0);
+
+  // As AddArgumentInput, but the 'size' elements are generated on the device by a built-in kernel
+  // instead of uploaded from the host. A generator gives the same data each time, so it can be used
+  // for the reference kernel as well.
+  template <typename T> void AddArgumentInputGenerated(const size_t id, const size_t size,
+                                                       const InputGenerator &generator);
+  template <typename T> void AddArgumentInputGeneratedReference(const size_t size,
+                                                                const InputGenerator &generator);
+
+  // Uploads a named buffer once, which can then be bound as an input or output argument to any
+  // kernel (including the reference) without another copy. Output arguments are copied before each
+  // run, so sharing them is safe as well. A buffer is freed once it is released and no kernel uses
+  // it anymore. Adding a buffer under an existing name replaces it for subsequent bindings.
+  template <typename T> void AddSharedBuffer(const std::string &name, const std::vector<T> &source);
+  void PUBLIC_API ReleaseSharedBuffer(const std::string &name);
+  void PUBLIC_API AddArgumentInputShared(const size_t id, const std::string &name);
+  void PUBLIC_API AddArgumentOutputShared(const size_t id, const std::string &name);
+  void PUBLIC_API AddArgumentInputSharedReference(const std::string &name);
+  void PUBLIC_API AddArgumentOutputSharedReference(const std::string &name);
+
+  // As AddArgumentInput/AddArgumentOutput, but the data stays in host memory and is streamed
+  // through the device in chunks, such that it does not have to fit in device memory. The kernel
+  // is launched once per chunk with the chunks as its arguments and is timed end-to-end, including
+  // the transfers. Other arguments are the same for all chunks; outputs all have to be streamed.
+  // The reference uses regular arguments (or a host reference function) with the full data.
+  template <typename T> void AddArgumentInputStreamed(const size_t id,
+                                                      const std::vector<T> &source);
+  template <typename T> void AddArgumentOutputStreamed(const size_t id,
+                                                       const std::vector<T> &source);
+
   // Configures a specific search method for given kernel. Default search method is full search.
   void PUBLIC_API UseFullSearch(const size_t id);
   void PUBLIC_API UseRandomSearch(const size_t id, const double fraction);
@@ -150,11 +382,67 @@ class Tuner {
                          const double influence_global, const double influence_local,
                          const double influence_random);
 
+  // Seeds the search of a kernel with its 'num_points' fastest configurations in the results file
+  // of an earlier run (see PrintJSON), e.g. tuned on another device or problem size. These are the
+  // first configurations of a full or random search, the initial positions of the PSO particles,
+  // and the initial state of simulated annealing. Can be called for multiple files.
+  void PUBLIC_API UseWarmStart(const size_t id, const std::string &filename,
+                               const size_t num_points);
+
+  // Reference outputs are cached in memory, such that the reference kernel is only run again when
+  // its source, thread-sizes, or arguments (including the contents of the buffers) change. This
+  // additionally stores them in the given directory, such that later tuning sessions can reuse them
+  // (memory-mapped) without running the reference kernel at all.
+  void PUBLIC_API UseReferenceCache(const std::string &directory);
+
   // Uses chosen method for results comparison. Currently available methods are absolute
   // difference and side by side comparison.
   void PUBLIC_API ChooseVerificationMethod(const VerificationMethod method,
                                               const double tolerance_treshold);
 
+  // As above, but defers the verification: all configurations are measured first, after which only
+  // the fastest ones are re-run and verified until 'verify_top_k' of them are correct. A random
+  // fraction 'audit_fraction' of the others is verified as well, as a sanity check. Unverified
+  // configurations are never selected as the best result, but their times do count for the
+  // relative time limit. Passing 0 for 'verify_top_k' verifies all configurations directly (the
+  // default).
+  void PUBLIC_API ChooseVerificationMethod(const VerificationMethod method,
+                                           const double tolerance_treshold,
+                                           const size_t verify_top_k, const double audit_fraction);
+
+  // Verifies only a sample of each output: ranges of consecutive elements at independently drawn
+  // positions. The number of ranges is chosen such that an output of which at least a fraction
+  // 'error_fraction' of the elements is incorrect is detected with probability
+  // 'detection_probability' (1 verifies all elements, the default). The positions are drawn with
+  // the given seed to make the verification reproducible. Outputs smaller than the sample are
+  // verified in full. The achieved confidence is reported with each result.
+  void PUBLIC_API UseSampledVerification(const double detection_probability,
+                                         const double error_fraction, const unsigned int seed);
+
+  // Distributes the tuning over worker processes. The tuner listens on the given address, either
+  // "tcp://host:port" (host '*' for all interfaces) or "unix:/path/to/socket". Workers are copies
+  // of the tuning program started with the CLTUNE_WORKER_ADDRESS environment variable set to the
+  // address: their tuning calls evaluate configurations for the coordinator on their own device.
+  // Optionally, a number of such workers are started on the local machine.
+  void PUBLIC_API UseDistributedTuning(const std::string &address, const size_t num_local_workers);
+
+  // Runs all configurations in a separate worker process (a copy of the tuning program, as above),
+  // such that crashes and hangs of the device or driver do not take down the tuner. A worker which
+  // crashes or takes longer than 'timeout_ms' for a configuration (0 for no limit) is restarted
+  // and the configuration is marked as failed. The worker keeps its context and buffers alive.
+  void PUBLIC_API UseIsolatedExecution(const float timeout_ms);
+
+  // Returns whether this process is a distributed tuning worker. Worker processes return empty
+  // results from the tuning functions.
+  bool PUBLIC_API IsDistributedWorker() const;
+
+  // Limits the compilation and run time of a single configuration (in milliseconds, 0 for no limit).
+  // Configurations exceeding a limit are abandoned and marked as timed out; the search strategies
+  // see them as strongly penalized results. The run-time limit can also be set relative to the best
+  // time found so far for the kernel (e.g. 10 times the best): the tighter of the two is used.
+  void PUBLIC_API SetTimeouts(const float compile_timeout_ms, const float run_timeout_ms);
+  void PUBLIC_API SetRelativeTimeout(const float multiple_of_best);
+
   // Outputs the search process to a file
   void PUBLIC_API OutputSearchLog(const std::string &filename);
 
@@ -165,6 +453,14 @@ class Tuner {
   // Starts the tuning process, but this time only for specified kernel.
   std::vector<PublicTunerResult> PUBLIC_API TuneSingleKernel(const size_t id);
 
+  // Tunes a kernel for each of a family of problem sizes and returns the intervals of sizes with
+  // the same best configuration. For each size, 'setup' is given a new tuner (on the same device)
+  // and the size: it adds the kernel with its parameters, ranges, and arguments for this size, and
+  // returns its ID. Sizes between two sizes with the same best configuration only run that
+  // configuration instead of being tuned.
+  std::vector<SweepInterval> PUBLIC_API TuneSweep(const std::vector<size_t> &sizes,
+                                                  SweepFunction setup);
+
   // Returns number of unique configurations for given kernel based on specified parameters and search method.
   // This method should be used only if using RunSingleKernel() method.
   size_t PUBLIC_API GetNumConfigurations(const size_t id) const;
@@ -200,6 +496,25 @@ class Tuner {
                             const std::vector<std::pair<std::string,std::string>> &descriptions) const;
   void PUBLIC_API PrintToFile(const std::string &filename) const;
 
+  // Generates a C++ header for applications with the best configuration of each tuned kernel for
+  // this device and the given problem-size class (e.g. "large"), as a constexpr table with lookup
+  // functions. Configurations already in the header are kept, except those which are replaced.
+  void PUBLIC_API PrintDispatchHeader(const std::string &filename,
+                                      const std::string &size_class) const;
+
+  // Compiles the best configuration of each tuned kernel and saves the binaries in a bundle file,
+  // from which applications can load them at startup (see BinaryBundle). Programs already in the
+  // bundle are kept, except those for the same kernel, device, and driver.
+  void PUBLIC_API SaveBinaryBundle(const std::string &filename);
+
+  // Generates a C++ header for applications with the intervals of the last sweep (see TuneSweep),
+  // including a constexpr function which selects the interval of a problem size
+  void PUBLIC_API PrintSweepHeader(const std::string &filename) const;
+
+  // Saves a trace of the tuner's internal phases and of the kernel executions on the device in the
+  // Chrome trace format (for chrome://tracing or Perfetto). Requires the TRACE build option.
+  void PUBLIC_API SaveTrace(const std::string &filename) const;
+
   // Disables all further printing to stdout
   void PUBLIC_API SuppressOutput();
 
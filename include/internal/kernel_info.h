@@ -86,6 +86,27 @@ class KernelInfo {
     BufferRaw buffer;   // The buffer on the device
   };
 
+  // Helper structure to store a device buffer which can be bound to the arguments of multiple
+  // kernels. It is freed when the last reference to it is gone.
+  struct SharedBuffer {
+    size_t size;             // The number of elements (not bytes)
+    MemType type;            // The data-type (e.g. float)
+    BufferRaw buffer;        // The buffer on the device
+    std::string description; // Identifies the contents (for the reference cache)
+    SharedBuffer(const SharedBuffer&) = delete;
+    SharedBuffer& operator=(const SharedBuffer&) = delete;
+    ~SharedBuffer();
+  };
+
+  // Helper structure to store an argument which stays in host memory: it is streamed through the
+  // device in chunks (see the streaming modifier below)
+  struct StreamedArgument {
+    size_t index;                    // The kernel-argument index
+    size_t size;                     // The number of elements (not bytes)
+    MemType type;                    // The data-type (e.g. float)
+    std::vector<unsigned char> data; // The input, or the initial contents of the output
+  };
+
   // Helper structure holding a setting: a name and a value. Multiple settings combined make a
   // single configuration.
   struct Setting {
@@ -110,6 +131,13 @@ class KernelInfo {
     std::string parameter_name;
   };
 
+  // Helper structure for streaming: the parameters holding the number of chunks and the number of
+  // chunks in flight (i.e. of queues)
+  struct StreamingModifier {
+    std::string chunks_parameter;
+    std::string in_flight_parameter;
+  };
+
   // Helper structure holding a constraint on parameters. This constraint consists of a constraint
   // function object and a vector of paramater names represented as strings.
   struct Constraint {
@@ -139,6 +167,9 @@ class KernelInfo {
   std::vector<Parameter> parameters() const { return parameters_; }
   IterationsModifier iterations() const { return iterations_; }
   size_t num_current_iterations() const { return num_current_iterations_; }
+  StreamingModifier streaming() const { return streaming_; }
+  size_t num_current_chunks() const { return num_current_chunks_; }
+  size_t num_current_in_flight() const { return num_current_in_flight_; }
   SearchMethod search_method() const { return search_method_; }
   std::vector<double> search_args() const { return search_args_; }
   IntRange global_base() const { return global_base_; }
@@ -149,6 +180,12 @@ class KernelInfo {
   size_t argument_counter() const { return argument_counter_; }
   std::vector<MemArgument> arguments_input() const { return arguments_input_; }
   std::vector<MemArgument> arguments_output() const { return arguments_output_; }
+  const std::vector<StreamedArgument>& arguments_input_streamed() const {
+    return arguments_input_streamed_;
+  }
+  const std::vector<StreamedArgument>& arguments_output_streamed() const {
+    return arguments_output_streamed_;
+  }
   std::vector<std::pair<size_t, int>> arguments_int() const { return arguments_int_; }
   std::vector<std::pair<size_t, size_t>> arguments_size_t() const { return arguments_size_t_; }
   std::vector<std::pair<size_t, float>> arguments_float() const { return arguments_float_; }
@@ -163,6 +200,15 @@ class KernelInfo {
     iterations_.valid_iterations = valid_iterations;
     iterations_.parameter_name = parameter_name;
   }
+  void set_streaming(const std::string &chunks_parameter, const std::string &in_flight_parameter) {
+    streaming_.chunks_parameter = chunks_parameter;
+    streaming_.in_flight_parameter = in_flight_parameter;
+  }
+
+  // Whether the kernel is run in streaming mode, i.e. has arguments in host memory
+  bool IsStreamed() const {
+    return !arguments_input_streamed_.empty() || !arguments_output_streamed_.empty();
+  }
 
   // Prepend to the source-code
   void PrependSource(const std::string &extra_source);
@@ -195,6 +241,9 @@ class KernelInfo {
   // Computes the number of iterations that kernel has to run based on the current configuration.
   void SetNumCurrentIterations(const Configuration &config);
 
+  // As above, but for the number of chunks and the number of chunks in flight of a streamed kernel
+  void SetNumCurrentChunks(const Configuration &config);
+
   // Computes all permutations based on the parameters and their values (the configuration list).
   // The result is stored as a member variable.
   void SetConfigurations();
@@ -209,6 +258,10 @@ class KernelInfo {
   // Methods that add a new argument to the kernel.
   void AddArgumentInput(const MemArgument &argument);
   void AddArgumentOutput(const MemArgument &argument);
+  void AddArgumentInput(const std::shared_ptr<SharedBuffer> &buffer);
+  void AddArgumentOutput(const std::shared_ptr<SharedBuffer> &buffer);
+  void AddArgumentInputStreamed(StreamedArgument argument);
+  void AddArgumentOutputStreamed(StreamedArgument argument);
   void AddArgumentScalar(const short argument);
   void AddArgumentScalar(const int argument);
   void AddArgumentScalar(const size_t argument);
@@ -235,6 +288,9 @@ class KernelInfo {
   LocalMemory local_memory_;
   IterationsModifier iterations_;
   size_t num_current_iterations_;
+  StreamingModifier streaming_;
+  size_t num_current_chunks_;
+  size_t num_current_in_flight_;
   SearchMethod search_method_;
   std::vector<double> search_args_;
 
@@ -250,6 +306,9 @@ class KernelInfo {
   size_t argument_counter_;
   std::vector<MemArgument> arguments_input_;
   std::vector<MemArgument> arguments_output_;
+  std::vector<std::shared_ptr<SharedBuffer>> shared_buffers_; // Not owned, but kept alive
+  std::vector<StreamedArgument> arguments_input_streamed_;
+  std::vector<StreamedArgument> arguments_output_streamed_;
   std::vector<std::pair<size_t, int>> arguments_int_;
   std::vector<std::pair<size_t, size_t>> arguments_size_t_;
   std::vector<std::pair<size_t, float>> arguments_float_;
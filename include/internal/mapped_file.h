@@ -0,0 +1,80 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the MappedFile class: a read-only view of (a byte range of) a file. On POSIX
+// systems the file is memory-mapped, such that only the parts in use are in host memory. The
+// class can hint the operating system to read ahead a range which is needed next, and to release a
+// range which is no longer needed. On Windows the range is read into memory instead.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_MAPPED_FILE_H_
+#define CLTUNE_MAPPED_FILE_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+namespace cltune {
+// =================================================================================================
+
+// See comment at top of file for a description of the class
+class MappedFile {
+ public:
+
+  // Maps 'size' bytes of a file starting at byte 'offset'. A size of 0 maps up to the end of the
+  // file. Throws if the file cannot be opened or if the range is not within the file.
+  explicit MappedFile(const std::string &filename, const size_t offset = 0, const size_t size = 0);
+  ~MappedFile();
+
+  // The mapping is neither copyable nor movable
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Accessors to the mapped range and the file's last modification time
+  const unsigned char* data() const { return data_; }
+  size_t size() const { return size_; }
+  long long modification_time() const { return modification_time_; }
+
+  // Hints that a range (relative to the start of the mapped range) is needed soon or no longer
+  // needed. These are no-ops on Windows.
+  void Prefetch(const size_t offset, const size_t size) const;
+  void Release(const size_t offset, const size_t size) const;
+
+ private:
+
+  // Applies advice to a range, extended to whole pages
+  void Advise(const size_t offset, const size_t size, const int advice) const;
+
+  void* mapping_;
+  size_t mapping_size_;
+  const unsigned char* data_;
+  size_t size_;
+  long long modification_time_;
+  std::vector<unsigned char> buffer_; // Windows only
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_MAPPED_FILE_H_
+#endif
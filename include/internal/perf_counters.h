@@ -0,0 +1,85 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the PerfCounters class, which counts hardware events (cycles, instructions,
+// last-level cache misses, branch misses, and optionally vector instructions) with the Linux
+// perf_event interface. On CPU devices the kernels run on threads of the host process, so the
+// events are counted for all threads of the process, as they exist when counting starts. Events
+// which are not supported by the processor are not counted. On other systems nothing is counted.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_PERF_COUNTERS_H_
+#define CLTUNE_PERF_COUNTERS_H_
+
+#include <vector> // std::vector
+#include <utility> // std::pair
+
+#include "internal/internal_api.h"
+
+namespace cltune {
+// =================================================================================================
+
+// See comment at top of file for a description of the class
+class PerfCounters {
+ public:
+
+  // The events, in the order of the fields of HardwareCounters
+  static constexpr auto kNumEvents = size_t{5};
+
+  // The vector instructions are counted with a processor-specific raw event code, 0 to skip them
+  explicit PerfCounters(const uint64_t vector_event);
+  ~PerfCounters();
+
+  // The counters are neither copyable nor movable
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Opens the counters on all current threads of the process and starts counting. Returns false if
+  // the counters could not be opened on any thread (e.g. not permitted, see perf_event_paranoid).
+  bool Start();
+
+  // Stops counting and adds the counts divided by 'num_runs' to 'counters'
+  void Stop(HardwareCounters &counters, const size_t num_runs);
+
+ private:
+
+  // The counters of a single thread: the first one leads the group, such that all are enabled,
+  // disabled, and read at once. The events are indices into 'events_'.
+  struct Group {
+    std::vector<int> descriptors;
+    std::vector<size_t> events;
+  };
+
+  // Closes the counters of all threads
+  void Close();
+
+  std::vector<std::pair<unsigned int, uint64_t>> events_; // Type and configuration of each event
+  std::vector<Group> groups_;
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_PERF_COUNTERS_H_
+#endif
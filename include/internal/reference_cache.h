@@ -0,0 +1,127 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the ReferenceOutputs and ReferenceCache classes. The outputs of a reference
+// run are stored on the host, either in memory or memory-mapped from a cache file. The cache maps
+// a key (describing the reference kernel, its arguments and the contents of its inputs) to such
+// outputs, such that the reference does not have to be run again for the same problem: neither by
+// a subsequent tuning call nor (when a cache directory is set) by a subsequent tuning session.
+//
+// A cache file consists of a header of 64-bit integers (magic number, key length, number of
+// outputs, and the size of each output in bytes), followed by the key and the outputs. The outputs
+// start at multiples of kAlignment bytes, such that they can be used directly when mapped.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_REFERENCE_CACHE_H_
+#define CLTUNE_REFERENCE_CACHE_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <memory> // std::shared_ptr
+#include <map> // std::map
+#include <cstdint> // uint64_t
+
+#include "internal/mapped_file.h"
+
+namespace cltune {
+// =================================================================================================
+
+// Computes the 64-bit FNV-1a hash of a block of memory. Pass a previous hash as the 'hash' argument
+// to continue hashing.
+constexpr auto kHashOffset = uint64_t{14695981039346656037ULL};
+uint64_t HashBytes(const void* data, const size_t size, const uint64_t hash = kHashOffset);
+
+// The host copies of the outputs of a single reference run
+class ReferenceOutputs {
+ public:
+
+  // Alignment (in bytes) of the outputs in a cache file
+  static constexpr auto kAlignment = size_t{64};
+
+  // Creates an empty set of outputs (in memory)
+  explicit ReferenceOutputs();
+
+  // The outputs can be memory-mapped: they are neither copyable nor movable
+  ReferenceOutputs(const ReferenceOutputs&) = delete;
+  ReferenceOutputs& operator=(const ReferenceOutputs&) = delete;
+
+  // Adds a new output of a given size (in bytes) and returns its data to be filled-in
+  void* AddOutput(const size_t size);
+
+  // Accessors to the outputs
+  size_t NumOutputs() const { return data_.size(); }
+  const void* Data(const size_t i) const { return data_[i]; }
+  void* Data(const size_t i) { return const_cast<void*>(data_[i]); } // In-memory outputs only
+  size_t Size(const size_t i) const { return sizes_[i]; }
+
+  // Loads the outputs from a cache file by memory-mapping it. Returns a nullptr if the file does not
+  // exist or if it was stored for a different key.
+  static std::shared_ptr<ReferenceOutputs> Load(const std::string &filename,
+                                                const std::string &key);
+
+  // Stores the outputs into a cache file. The file is written under a temporary name first, such
+  // that other processes never see a partially written file.
+  void Save(const std::string &filename, const std::string &key) const;
+
+ private:
+  std::vector<std::vector<unsigned char>> buffers_; // In-memory outputs
+  std::unique_ptr<MappedFile> file_; // Memory-mapped cache file (if any)
+  std::vector<const void*> data_;
+  std::vector<size_t> sizes_;
+};
+
+// =================================================================================================
+
+// Stores reference outputs in memory and optionally in a directory on disk, see the comment at the
+// top of the file
+class ReferenceCache {
+ public:
+
+  // Initializes an in-memory cache
+  explicit ReferenceCache();
+
+  // Sets the directory for the on-disk cache (an empty string for an in-memory cache only)
+  void SetDirectory(const std::string &directory);
+
+  // Returns the outputs stored for the given key, either from memory or from disk. Returns a
+  // nullptr if they are not in the cache.
+  std::shared_ptr<const ReferenceOutputs> Find(const std::string &key);
+
+  // Stores the outputs for the given key in memory and (if a directory is set) on disk
+  void Store(const std::string &key, const std::shared_ptr<const ReferenceOutputs> &outputs);
+
+ private:
+
+  // Returns the name of the cache file for a key
+  std::string FileName(const std::string &key) const;
+
+  std::string directory_;
+  std::map<std::string, std::shared_ptr<const ReferenceOutputs>> entries_;
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_REFERENCE_CACHE_H_
+#endif
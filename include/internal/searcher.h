@@ -8,7 +8,8 @@
 // This file contains a base class for search algorithms. It is meant to be inherited by other less
 // abstract search algorithms, such as full search or a random search. The pure virtual functions
 // declared here are customised in the derived classes. This class stores all configurations which
-// could be examined, and receives feedback from the tuner in the form of execution time.
+// could be examined, and receives feedback from the tuner in the form of execution time. It can
+// also receive multiple objectives per configuration, and keeps track of their Pareto front.
 //
 // -------------------------------------------------------------------------------------------------
 //
@@ -35,6 +36,7 @@
 #include <chrono>
 
 #include "internal/kernel_info.h"
+#include "internal/trace.h"
 
 namespace cltune {
 // =================================================================================================
@@ -53,9 +55,35 @@ class Searcher {
   // Pushes feedback (in the form of execution time) from the tuner to the search algorithm
   virtual void PushExecutionTime(const double execution_time);
 
+  // Pushes multiple objectives (lower is better) of the current configuration before its execution
+  // time, empty for a failed configuration. The Pareto front is the list of indices of the explored
+  // configurations which are not dominated by any other.
+  void PushObjectives(const std::vector<double> &objectives);
+  const std::vector<size_t>& pareto_front() const { return pareto_front_; }
+  const std::vector<double>& objectives(const size_t index) const { return objectives_[index]; }
+
+  // Whether 'a' dominates 'b': it is at least as good in all objectives and better in at least one.
+  // Also returns the indices of the points which are not dominated by any other.
+  static bool Dominates(const std::vector<double> &a, const std::vector<double> &b);
+  static std::vector<size_t> ParetoFront(const std::vector<std::vector<double>> &points);
+
   // Prints the log of the search process
   void PrintLog(FILE* fp) const;
 
+  // Batch evaluation: retrieves up to 'max_size' upcoming configurations which do not depend on
+  // each other's feedback and can thus be evaluated concurrently. Their execution times are pushed
+  // back in the same order using PushBatch, which behaves as the sequential tuning loop. The
+  // objectives are optional (see PushObjectives).
+  std::vector<KernelInfo::Configuration> GetBatch(const size_t max_size) const;
+  void PushBatch(const std::vector<double> &execution_times,
+                 const std::vector<std::vector<double>> &objectives);
+
+  // Seeds the search with known good configurations (best first), e.g. from tuning on another
+  // device or problem size. Must be called before the first configuration is retrieved.
+  // Configurations outside the search space are ignored. By default, the starting points are
+  // evaluated first.
+  virtual void SetStartingPoints(const Configurations &points);
+
   // Pure virtual functions: these are overriden by the derived classes
   virtual KernelInfo::Configuration GetConfiguration() = 0;
   virtual void CalculateNextIndex() = 0;
@@ -63,6 +91,13 @@ class Searcher {
 
  protected:
 
+  // Returns the indices of the upcoming independent configurations (see GetBatch). By default this
+  // is only the current one, derived classes can override this when they know more.
+  virtual std::vector<size_t> NextIndices(const size_t max_size) const;
+
+  // Returns the index of a configuration, or the number of configurations if it is not one of them
+  size_t IndexOf(const KernelInfo::Configuration &target) const;
+
   // Pseudo-random seed based on the time
   unsigned int RandomSeed() const {
     // std::random_device rd;
@@ -75,6 +110,8 @@ class Searcher {
   std::vector<double> execution_times_;
   std::vector<size_t> explored_indices_;
   size_t index_;
+  std::vector<std::vector<double>> objectives_;
+  std::vector<size_t> pareto_front_;
 };
 
 // =================================================================================================
@@ -64,6 +64,9 @@ class Annealing: public Searcher {
   // Pushes feedback (in the form of execution time) from the tuner to the search algorithm
   virtual void PushExecutionTime(const double execution_time) override;
 
+  // Starts from the best starting point instead of from a random state
+  virtual void SetStartingPoints(const Configurations &points) override;
+
  private:
 
   // Retrieves a vector with all neighbours of a reference configuration
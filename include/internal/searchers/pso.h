@@ -67,10 +67,15 @@ class PSO: public Searcher {
   // Pushes feedback (in the form of execution time) from the tuner to the search algorithm
   virtual void PushExecutionTime(const double execution_time) override;
 
- private:
+  // Places the first particles of the swarm on the starting points
+  virtual void SetStartingPoints(const Configurations &points) override;
+
+ protected:
 
-  // Returns the index of the target configuration in the whole configuration list
-  size_t IndexFromConfiguration(const KernelInfo::Configuration target) const;
+  // The remaining particles of the current sweep over the swarm are independent of each other
+  virtual std::vector<size_t> NextIndices(const size_t max_size) const override;
+
+ private:
 
   // Configuration parameters
   double fraction_;
@@ -53,6 +53,11 @@ class RandomSearch: public Searcher {
   // Retrieves the total number of configurations to try
   virtual size_t NumConfigurations() override;
 
+ protected:
+
+  // All upcoming configurations are independent: the order is fixed up-front
+  virtual std::vector<size_t> NextIndices(const size_t max_size) const override;
+
  private:
     double fraction_;
 };
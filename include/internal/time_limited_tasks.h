@@ -0,0 +1,88 @@
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the TimeLimitedTasks class, which runs tasks (such as compilations) on their
+// own thread and waits for each of them for at most a time limit. A task which exceeds its limit is
+// abandoned: it keeps running in the background while the caller continues. The number of
+// abandoned tasks which are still running is bounded: the oldest of them is waited for only when
+// abandoning another task would exceed the maximum.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_TIME_LIMITED_TASKS_H_
+#define CLTUNE_TIME_LIMITED_TASKS_H_
+
+#include <deque> // std::deque
+#include <thread> // std::thread
+#include <future> // std::future
+#include <functional> // std::function
+
+namespace cltune {
+// =================================================================================================
+
+// See comment at top of file for a description of the class
+class TimeLimitedTasks {
+ public:
+
+  // Allows at most 'max_abandoned' abandoned tasks to run at the same time (at least one)
+  explicit TimeLimitedTasks(const size_t max_abandoned);
+
+  // Waits for all abandoned tasks to finish
+  ~TimeLimitedTasks();
+
+  // The tasks are neither copyable nor movable
+  TimeLimitedTasks(const TimeLimitedTasks&) = delete;
+  TimeLimitedTasks& operator=(const TimeLimitedTasks&) = delete;
+
+  // Runs a task for at most 'limit_ms' milliseconds. Returns true if it finished in time (passing
+  // on its exceptions), or false if it was abandoned. The task must not refer to objects which
+  // might not outlive it: an abandoned task finishes at a later time.
+  bool Run(std::function<void()> task, const float limit_ms);
+
+  // Waits until another task can be abandoned without exceeding the maximum. Otherwise, Run waits
+  // after abandoning a task, so callers which time their tasks call this before starting the clock.
+  void WaitForSlot();
+
+  // Returns the number of abandoned tasks which are still running
+  size_t NumAbandoned();
+
+ private:
+
+  // Waits for the oldest abandoned tasks until at most 'num_tasks' of them are still running
+  void WaitUntilAtMost(const size_t num_tasks);
+
+  // Forgets about abandoned tasks which have finished
+  void RemoveFinished();
+
+  struct Abandoned {
+    std::thread thread;
+    std::future<void> done;
+  };
+  size_t max_abandoned_;
+  std::deque<Abandoned> abandoned_; // Ordered from the oldest to the newest
+};
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_TIME_LIMITED_TASKS_H_
+#endif
@@ -0,0 +1,93 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the Trace class, which records spans of the internal phases of the tuner (e.g.
+// enumeration, compilation, launches, verification, and searcher updates) per host thread, as well
+// as the kernel executions on the device. The trace can be saved in the Chrome trace format (JSON),
+// to be viewed in chrome://tracing or in Perfetto.
+//
+// Spans are recorded by the TRACE_SPAN macro, which compiles to nothing unless the tuner is built
+// with the TRACE option (defining CLTUNE_TRACE). Device events are placed on the host timeline by
+// their profiling timestamps, relative to the host time at which they were enqueued.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_TRACE_H_
+#define CLTUNE_TRACE_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+namespace cltune {
+// =================================================================================================
+
+// See comment at top of file for a description of the class. All methods are thread-safe.
+class Trace {
+ public:
+
+  // Returns the time in microseconds since the start of the trace
+  static double Now();
+
+  // Records a span on the current host thread, or on the device (times in microseconds)
+  static void AddSpan(const char* category, const std::string &name, const double start,
+                      const double end);
+  static void AddDeviceSpan(const std::string &name, const double start, const double end);
+
+  // Records a kernel execution on the device from its profiling timestamps (queued, submitted,
+  // started, and ended, in ns) and the host time at which it was enqueued
+  static void AddDeviceEvent(const std::string &name, const double enqueue_time,
+                             const std::vector<unsigned long long> &timestamps);
+
+  // Saves all spans recorded so far as a Chrome trace
+  static void Save(const std::string &filename);
+};
+
+// Records a span from its construction until its destruction
+class TraceSpan {
+ public:
+  TraceSpan(const char* category, const std::string &name):
+      category_(category), name_(name), start_(Trace::Now()) { }
+  ~TraceSpan() { Trace::AddSpan(category_, name_, start_, Trace::Now()); }
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+ private:
+  const char* category_;
+  std::string name_;
+  double start_;
+};
+
+// Traces the remainder of the current scope
+#ifdef CLTUNE_TRACE
+  #define TRACE_CONCAT_(a, b) a##b
+  #define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+  #define TRACE_SPAN(category, name) \
+    cltune::TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(category, name)
+#else
+  #define TRACE_SPAN(category, name)
+#endif
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_TRACE_H_
+#endif
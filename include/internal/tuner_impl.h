@@ -40,12 +40,24 @@
 #endif
 
 #include "internal/searcher.h"
+#include "internal/distributed.h"
+#include "internal/reference_cache.h"
+#include "internal/time_limited_tasks.h"
+#include "internal/mapped_file.h"
+#include "internal/perf_counters.h"
+#include "internal/energy_meter.h"
+#include "internal/background_load.h"
 
 #include <string> // std::string
 #include <vector> // std::vector
 #include <memory> // std::shared_ptr
 #include <complex> // std::complex
 #include <stdexcept> // std::runtime_error
+#include <deque> // std::deque
+#include <future> // std::future
+#include <random> // std::mt19937
+#include <map> // std::map
+#include <chrono> // std::chrono::steady_clock
 
 namespace cltune {
 // =================================================================================================
@@ -57,6 +69,13 @@ class TunerImpl {
 
   // Parameters
   static constexpr auto kMaxL2Norm = 1e-4; // This is the threshold for 'correctness'
+  static constexpr auto kTimeoutPenalty = 10.0f; // Searchers see timed-out results as this x limit
+  static constexpr auto kStagingBuffers = size_t{2}; // Double-buffering for pipelined verification
+  static constexpr auto kSampleChunkSize = size_t{256}; // Consecutive elements per sampled range
+  static constexpr auto kFileChunkSize = size_t{64} << 20; // Bytes per transfer of a file argument
+  static constexpr auto kMaxAbandonedBuilds = size_t{4}; // Timed-out compilations left running
+  static constexpr auto kDriftPauseMs = 1000; // Pause before re-running a drifted baseline
+  static constexpr auto kMaxDriftPauses = size_t{10}; // Pauses before accepting a drifted baseline
 
   // Messages printed to stdout (in colours)
   static const std::string kMessageFull;
@@ -77,6 +96,61 @@ class TunerImpl {
     size_t threads;
     bool status;
     KernelInfo::Configuration configuration;
+    std::string failure_reason;
+    bool timed_out;
+    double confidence; // Probability that the verification detects an incorrect output
+    size_t peak_memory; // Peak device memory allocated by the tuner during the run (bytes)
+    RunTimings timings; // The time by each metric: 'time' is the one selected by 'timing_metric_'
+    HardwareCounters counters; // Counts per launch, if 'perf_counters_' is set
+    float energy; // Energy per launch (J), if 'energy_meter_' is set
+    float power; // Average power during the launches (W), if 'energy_meter_' is set
+    float compile_time; // Time to compile the kernel (ms)
+    size_t local_memory; // Local memory used by the kernel (bytes)
+    std::vector<float> run_times; // The time of each run by 'timing_metric_'
+    float drift; // Time of the drift sentinel's baseline relative to its initial time
+    bool unverified; // Measured but not (yet) verified, in case of deferred verification
+  };
+
+  // The baseline configuration of a kernel which is re-run to detect drift, and its initial time
+  struct DriftSentinel {
+    KernelInfo::Configuration baseline;
+    size_t interval;
+    double tolerance;
+    DriftAction action;
+    float baseline_time;
+  };
+
+  // The elements of an output which are read back for verification: ranges of 'chunk' consecutive
+  // elements, starting at the (sorted) 'offsets'. A full verification is a single range covering
+  // the whole output.
+  struct OutputSample {
+    std::vector<size_t> offsets;
+    size_t chunk;
+    size_t size() const { return chunk * offsets.size(); }
+  };
+
+  // Helper structures for pipelined verification: a downloaded output and a result waiting for the
+  // comparison of its outputs against the reference
+  struct StagedOutput {
+    MemType type;
+    OutputSample sample;
+    std::vector<unsigned char> data;
+  };
+  struct PendingVerification {
+    TunerResult result;
+    std::future<bool> status;
+  };
+
+  // Thrown when a compilation or kernel run exceeds its time limit
+  class TimeoutError: public std::runtime_error {
+   public:
+    explicit TimeoutError(const std::string &message, const float limit_ms):
+        std::runtime_error(message + " after " + std::to_string(static_cast<size_t>(limit_ms)) +
+                           " ms"),
+        limit_ms_(limit_ms) { }
+    float limit_ms() const { return limit_ms_; }
+   private:
+    float limit_ms_;
   };
 
   // Initialize either with platform 0 and device 0 or with a custom platform/device
@@ -94,10 +168,53 @@ class TunerImpl {
   // Starts the tuning process for all kernels.
   std::vector<PublicTunerResult> TuneAllKernels();
 
+  // Distributed tuning: evaluates all configurations of a kernel on the connected workers, or (in
+  // a worker process) serves the coordinator until it has finished
+  void TuneDistributed(const size_t id, Searcher &searcher);
+  void ServeAsWorker();
+  bool IsDistributedWorker() const;
+
   // Compiles and runs a kernel and returns the elapsed time
   TunerResult RunKernel(const std::string &source, const KernelInfo &kernel,
                         const size_t configuration_id, const size_t num_configurations);
 
+  // Runs a streamed kernel: its host-resident arguments are uploaded, computed on, and downloaded
+  // in chunks using multiple queues. Returns the timings of the whole pipeline.
+  RunTimings RunStreamed(const Program &program, const KernelInfo &kernel, const float run_limit_ms,
+                    const std::chrono::steady_clock::time_point run_start);
+
+  // Compiles a program within the compilation time limit (if any). A compilation which exceeds the
+  // limit is abandoned and keeps running in the background while tuning continues. Only when
+  // kMaxAbandonedBuilds of them are still running, the next compilation waits for the oldest.
+  BuildStatus BuildProgram(Program &program, std::vector<std::string> &options);
+
+  // Returns the current limit on the run time of a configuration in milliseconds (0 for no limit)
+  float RunTimeLimit() const;
+
+  // Returns the execution time to feed to the searcher: timed-out results are strongly penalized
+  float SearcherFeedback(const TunerResult &result) const;
+
+  // Drift sentinel: runs the baseline configuration of a kernel and returns its time, and checks
+  // the baseline for drift, handling the results from 'first_affected' onwards if it has drifted
+  float RunBaseline(const size_t id, const KernelInfo::Configuration &baseline);
+  void CheckDrift(const size_t id, DriftSentinel &sentinel, const size_t num_explored,
+                  const size_t first_affected);
+
+  // Summarizes the times of the runs of a configuration by 'run_statistic_'
+  float RunStatisticOf(std::vector<float> run_times) const;
+
+  // Multi-objective support: the value of an objective of a result, the reason why a result
+  // violates the objective constraints (empty if it does not), the objectives of a result for the
+  // Pareto front (empty for failures), and which of the results are on the Pareto front of their
+  // kernel. The latter only considers correct results.
+  double ObjectiveValue(const TunerResult &result, const Objective objective) const;
+  std::string ConstraintViolation(const TunerResult &result) const;
+  std::vector<double> ParetoObjectives(const TunerResult &result) const;
+  std::vector<bool> ParetoOptimal() const;
+
+  // Prints and stores the result of a configuration
+  void StoreResult(TunerResult tuning_result);
+
   // Converts TunerResult object to PublicTunerResult.
   PublicTunerResult ConvertTuningResultToPublic(const TunerResult &result);
 
@@ -119,19 +236,66 @@ class TunerImpl {
   // Returns modified kernel source (with #defines) based on provided configuration.
   std::string GetConfiguredKernelSource(const size_t id, const KernelInfo::Configuration& configuration);
 
-  // Runs reference kernel and stores its result.
+  // Runs reference kernel and stores its result. The result is taken from the cache if possible.
   void RunReferenceKernel();
 
+  // As above, but for a host reference function: starts it on a separate thread
+  void RunReferenceFunction();
+  void SetReferenceOutputs(const std::shared_ptr<const ReferenceOutputs> &outputs);
+
+  // Describes the reference kernel and its arguments for the reference cache
+  std::string ReferenceKey() const;
+  void AddReferenceArgumentKey(const std::string &kind, const MemType type, const void* data,
+                               const size_t size);
+
+  // Creates a buffer for a kernel argument and uploads its data (through a mapping for zero-copy)
+  template <typename T> BufferRaw UploadArgument(const std::vector<T> &source);
+  template <typename T> BufferRaw UploadFile(const MappedFile &file);
+
+  // Returns the device memory (in bytes) needed to run a kernel: the copies of its outputs and the
+  // chunks in flight of its streamed arguments
+  size_t RunFootprint(const KernelInfo &kernel) const;
+
+  // Returns the shared buffer with the given name
+  std::shared_ptr<KernelInfo::SharedBuffer> GetSharedBuffer(const std::string &name) const;
+
+  // Creates a buffer for a kernel argument and fills it on the device with the input generator
+  template <typename T> BufferRaw GenerateArgument(const size_t size,
+                                                   const InputGenerator &generator);
+
   // Copies an output buffer
   template <typename T> KernelInfo::MemArgument CopyOutputBuffer(KernelInfo::MemArgument &argument);
 
   // Stores the output of the reference run into the host memory
   void StoreReferenceOutput();
-  template <typename T> void DownloadReference(KernelInfo::MemArgument &device_buffer);
+  template <typename T> void DownloadReference(KernelInfo::MemArgument &device_buffer,
+                                               ReferenceOutputs &outputs);
 
   // Downloads the output of a tuning run and compares it against the reference run
   bool VerifyOutput();
   template <typename T> bool DownloadAndCompare(KernelInfo::MemArgument &device_buffer, const size_t i);
+  template <typename T> bool CompareOutput(const T* host_buffer, const OutputSample &sample,
+                                          const size_t i);
+
+  // Selects the elements of an output to verify and computes the resulting detection probability
+  OutputSample SampleOutput(const size_t size);
+  size_t SampleSize(const size_t size) const;
+  double VerificationConfidence(const KernelInfo &kernel) const;
+  template <typename T> void ReadSample(KernelInfo::MemArgument &device_buffer,
+                                        const OutputSample &sample, T* host_buffer);
+
+  // As above, but downloads into a staging buffer and compares on a separate host thread. The
+  // result is stored once it is verified, see the implementation for details.
+  void VerifyOutputAsync(const TunerResult &tuning_result);
+  void FinishVerification();
+  template <typename T> void StageOutput(KernelInfo::MemArgument &device_buffer, StagedOutput &staged);
+  bool CompareStagedOutputs(const std::vector<StagedOutput> &staging_buffer,
+                            const size_t first = 0);
+
+  // Deferred verification of only the fastest results (and a random audit) after measuring them
+  void VerifyDeferred(const size_t id, const size_t first_result);
+  bool VerifyResult(const size_t id, TunerResult &result);
+  template <typename T> bool CompareStagedOutput(const StagedOutput &staged, const size_t i);
   template <typename T> double AbsoluteDifference(const T reference, const T result);
 
   // Trains and uses a machine learning model based on the search space explored so far
@@ -163,24 +327,85 @@ class TunerImpl {
   Queue queue_;
 
   // Settings
-  size_t num_runs_; // This was used for more-accurate execution time measurement, currently always one
+  size_t num_runs_; // The number of runs of each configuration, summarized by 'run_statistic_'
+  RunStatistic run_statistic_;
+  double run_statistic_parameter_; // The percentile or the multiple of the standard deviation
+  size_t background_threads_; // Number of host threads kept busy during the runs
   bool has_reference_;
   bool suppress_output_;
   bool output_search_process_;
   std::string search_log_filename_;
+  BufferMemory buffer_memory_; // Host memory for zero-copy arguments (the default for CPUs)
+  std::map<MemType, Program> generator_programs_; // Compiled input generators per data-type
+  size_t memory_budget_; // Device memory available to the tuner in bytes (0 for all memory)
+  TimingMetric timing_metric_; // The metric reported as the time of a run
+  std::unique_ptr<PerfCounters> perf_counters_; // Hardware counters of the launches, if enabled
+  std::unique_ptr<EnergyMeter> energy_meter_; // Energy measurement of the launches, if enabled
+  std::vector<std::pair<Objective,double>> objective_weights_; // What the searchers minimize
+  std::vector<std::pair<Objective,double>> objective_constraints_; // Maximum of each objective
+  std::vector<Objective> pareto_objectives_; // Objectives of the Pareto front (empty for none)
+  std::map<size_t, DriftSentinel> drift_sentinels_; // Per kernel ID, if enabled
+  std::vector<DriftEvent> drift_events_;
+  float drift_; // The drift of the current kernel's baseline, 1 if within the tolerance
+  size_t platform_id_; // For the tuners of the problem sizes of a sweep
+  size_t device_id_;
+  std::string sweep_kernel_;
+  std::vector<SweepInterval> sweep_intervals_; // The result of the last sweep
+  std::map<size_t, Searcher::Configurations> warm_starts_; // Starting points per kernel ID
+
+  // Distributed tuning settings and the coordinator (created at the first tuning run). Isolated
+  // execution uses the same mechanism with a single local worker.
+  std::string distributed_address_;
+  size_t num_local_workers_;
+  size_t max_worker_losses_;
+  float worker_timeout_ms_;
+  std::unique_ptr<Coordinator> coordinator_;
+  bool worker_finished_;
+
+  // Time limits: fixed limits for compilation and kernel runs and a run-time limit relative to the
+  // best time found so far for the current kernel
+  float compile_timeout_ms_;
+  float run_timeout_ms_;
+  float relative_timeout_;
+  float best_time_; // Also of unverified results when verification is deferred
+  TimeLimitedTasks builds_; // Runs the compilations which have a time limit
 
   // Verification method settings
   VerificationMethod verification_method_;
   double tolerance_treshold_;
+  size_t verify_top_k_; // 0 means verifying every configuration directly
+  double audit_fraction_;
+
+  // Sampled verification settings and the random generator for the sample positions
+  double detection_probability_; // 1 means verifying all elements
+  double error_fraction_;
+  std::mt19937 sample_generator_;
 
-  // Storage of kernels, kernel searchers and output copy buffers
+  // Storage of kernels, kernel searchers, output copy buffers, and named buffers shared by kernels
   std::vector<KernelInfo> kernels_;
   std::vector<std::unique_ptr<Searcher>> kernel_searchers_;
   std::vector<KernelInfo::MemArgument> arguments_output_copy_; // these may be modified by the kernel
-
-  // Storage for the reference kernel and output
+  std::map<std::string, std::shared_ptr<KernelInfo::SharedBuffer>> shared_buffers_;
+
+  // Host memory for the outputs of a streamed kernel (verified like the output copies above) and
+  // the additional queues for streaming, created when first needed
+  std::vector<StagedOutput> streamed_outputs_;
+  std::vector<Queue> stream_queues_;
+
+  // Double-buffered host staging area and the results waiting for verification (in order)
+  std::vector<std::vector<StagedOutput>> staging_buffers_;
+  size_t next_staging_buffer_;
+  std::deque<PendingVerification> pending_verifications_;
+
+  // Storage for the reference (either a kernel or a host function) and its output, and the cache of
+  // reference outputs. The arguments of the reference kernel are described (including a hash of
+  // their contents) for the cache key. The output is a future, since a host reference function
+  // might still be running: only the comparisons wait for it.
   std::unique_ptr<KernelInfo> reference_kernel_;
-  std::vector<void*> reference_outputs_;
+  ReferenceFunction reference_function_;
+  std::string reference_arguments_;
+  std::shared_future<std::shared_ptr<const ReferenceOutputs>> reference_outputs_;
+  ReferenceCache reference_cache_;
 
   // List of tuning results
   std::vector<TunerResult> tuning_results_;
@@ -0,0 +1,50 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file contains the reader of previous tuning results for warm starts (see UseWarmStart). It
+// reads the JSON files written by PrintJSON: only the kernel name, time, and parameters of each
+// result are used, such that results of other devices, drivers, or problem sizes can be used as
+// well.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+#ifndef CLTUNE_WARM_START_H_
+#define CLTUNE_WARM_START_H_
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+#include "internal/internal_api.h"
+
+namespace cltune {
+// =================================================================================================
+
+// Reads the configurations of the results of a kernel, ordered from fastest to slowest. Throws if
+// the file cannot be opened or is not a results file.
+std::vector<ParameterRange> ReadWarmStart(const std::string &filename, const std::string &kernel);
+
+// =================================================================================================
+} // namespace cltune
+
+// CLTUNE_WARM_START_H_
+#endif
@@ -87,18 +87,23 @@ int main(int argc, char** argv)
     // Reference kernel has to always run in single iteration
     tuner.setReference(std::vector<std::string>{ referenceKernelName }, "referenceKernel", ndRangeDimensions, workGroupDimensions);
 
+    // The buffers are uploaded once and shared by the kernel and the reference kernel
+    tuner.addSharedBuffer("a", a);
+    tuner.addSharedBuffer("b", b);
+    tuner.addSharedBuffer("result", result);
+
     // Each kernel takes separate arguments
     tuner.addArgumentScalar(kernelId, 2.0f);
-    tuner.addArgumentInput(kernelId, a);
-    tuner.addArgumentInput(kernelId, b);
-    tuner.addArgumentOutput(kernelId, result);
+    tuner.addArgumentInputShared(kernelId, "a");
+    tuner.addArgumentInputShared(kernelId, "b");
+    tuner.addArgumentOutputShared(kernelId, "result");
 
     // Different method is used for adding arguments to reference kernel, output buffers for all kernels should have the same size so the results
     // comparison is possible
     tuner.addArgumentScalarReference(2.0f);
-    tuner.addArgumentInputReference(a);
-    tuner.addArgumentInputReference(b);
-    tuner.addArgumentOutputReference(result);
+    tuner.addArgumentInputSharedReference("a");
+    tuner.addArgumentInputSharedReference("b");
+    tuner.addArgumentOutputSharedReference("result");
 
     // Explicitly choose full search option (this is here to show correct usage, full search is default option so calling this is not strictly necessary)
     tuner.useFullSearch(kernelId);
@@ -0,0 +1,59 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the BackgroundLoad class (see the header for information about the class).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/background_load.h"
+
+namespace cltune {
+// =================================================================================================
+
+// Each thread reads and writes a cache line at a time. The stop flag is checked after every 64KB,
+// such that the threads stop promptly.
+BackgroundLoad::BackgroundLoad(const size_t num_threads):
+    stop_(false),
+    threads_() {
+  for (auto t = size_t{0}; t < num_threads; ++t) {
+    threads_.emplace_back([this]() {
+      const auto kLineSize = size_t{64};
+      const auto kCheckInterval = size_t{64 * 1024};
+      auto buffer = std::vector<unsigned char>(kBufferSize);
+      auto i = size_t{0};
+      while (!stop_.load(std::memory_order_relaxed)) {
+        for (auto end = i + kCheckInterval; i < end; i += kLineSize) { buffer[i] += 1; }
+        if (i >= kBufferSize) { i = 0; }
+      }
+    });
+  }
+}
+
+BackgroundLoad::~BackgroundLoad() {
+  stop_ = true;
+  for (auto &thread: threads_) { thread.join(); }
+}
+
+// =================================================================================================
+} // namespace cltune
@@ -0,0 +1,187 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the BinaryBundle class (see the header for information about the class).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/binary_bundle.h"
+
+#include <fstream> // std::ofstream
+#include <future> // std::async, std::future
+#include <cstdio> // std::rename, std::remove
+#include <cstdint> // uint64_t
+#include <stdexcept> // std::runtime_error
+
+#ifdef _WIN32
+  #include <process.h> // _getpid
+#else
+  #include <unistd.h> // getpid
+#endif
+
+namespace cltune {
+// =================================================================================================
+
+// Identifies a bundle file ("CLTUNBIN" in ASCII)
+constexpr auto kBundleMagic = uint64_t{0x434C54554E42494EULL};
+
+// Rounds a file offset up to the alignment of the fields
+static size_t AlignField(const size_t offset) {
+  const auto alignment = BinaryBundle::kAlignment;
+  return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+// The fields of an entry in the order in which they are stored
+static std::vector<const std::string*> EntryFields(const BundleEntry &entry) {
+  return {&entry.kernel, &entry.device, &entry.driver, &entry.source, &entry.binary};
+}
+
+// =================================================================================================
+
+// Maps the file and reads its index, checking that all fields are within the file
+BinaryBundle::BinaryBundle(const std::string &filename):
+    file_(new MappedFile(filename)),
+    index_() {
+  auto size = file_->size();
+  auto header = reinterpret_cast<const uint64_t*>(file_->data());
+  if (size < 2 * sizeof(uint64_t) || header[0] != kBundleMagic) {
+    throw std::runtime_error("Not a binary bundle: " + filename);
+  }
+  auto num_entries = static_cast<size_t>(header[1]);
+  if (num_entries > (size - 2 * sizeof(uint64_t)) / (2 * kNumFields * sizeof(uint64_t))) {
+    throw std::runtime_error("Invalid binary bundle: " + filename);
+  }
+  for (auto e = size_t{0}; e < num_entries; ++e) {
+    auto fields = std::vector<Field>();
+    for (auto f = size_t{0}; f < kNumFields; ++f) {
+      auto location = header + 2 + 2 * (e * kNumFields + f);
+      auto field = Field{static_cast<size_t>(location[0]), static_cast<size_t>(location[1])};
+      if (field.offset > size || field.size > size - field.offset) {
+        throw std::runtime_error("Invalid binary bundle: " + filename);
+      }
+      fields.push_back(field);
+    }
+    index_.push_back(fields);
+  }
+}
+
+// Copies a field out of the mapping
+std::string BinaryBundle::Read(const Field &field) const {
+  return std::string(reinterpret_cast<const char*>(file_->data() + field.offset), field.size);
+}
+
+// Copies all entries
+std::vector<BundleEntry> BinaryBundle::Entries() const {
+  auto entries = std::vector<BundleEntry>();
+  for (auto &fields: index_) {
+    entries.push_back(BundleEntry{Read(fields[0]), Read(fields[1]), Read(fields[2]),
+                                  Read(fields[3]), Read(fields[4])});
+  }
+  return entries;
+}
+
+// Selects one program per kernel (the one for this driver if there is one, otherwise any one for
+// this device) and builds each of them on its own thread
+std::map<std::string, Program> BinaryBundle::Load(const Context &context,
+                                                  const Device &device) const {
+  auto device_name = device.Name();
+  auto driver = device.DriverVersion();
+  auto selected = std::map<std::string, size_t>();
+  for (auto e = size_t{0}; e < index_.size(); ++e) {
+    if (Read(index_[e][1]) != device_name) { continue; }
+    auto kernel = Read(index_[e][0]);
+    if (selected.find(kernel) == selected.end() || Read(index_[e][2]) == driver) {
+      selected[kernel] = e;
+    }
+  }
+
+  auto builds = std::vector<std::pair<std::string, std::future<Program>>>();
+  for (auto &selection: selected) {
+    auto &fields = index_[selection.second];
+    auto build = [this, &fields, &context, &device, &driver]() -> Program {
+      auto options = std::vector<std::string>();
+      if (Read(fields[2]) == driver) {
+        try {
+          auto program = Program(device, context, Read(fields[4]));
+          if (program.Build(device, options) == BuildStatus::kSuccess) { return program; }
+        } catch (std::runtime_error&) { } // The binary is rejected by the driver
+      }
+      auto program = Program(context, Read(fields[3]));
+      if (program.Build(device, options) != BuildStatus::kSuccess) {
+        throw std::runtime_error("Could not compile " + Read(fields[0]) + " from the bundle: " +
+                                 program.GetBuildInfo(device));
+      }
+      return program;
+    };
+    builds.push_back({selection.first, std::async(std::launch::async, build)});
+  }
+  auto programs = std::map<std::string, Program>();
+  for (auto &build: builds) { programs.emplace(build.first, build.second.get()); }
+  return programs;
+}
+
+// Writes the index followed by the fields (each aligned)
+void BinaryBundle::Save(const std::string &filename, const std::vector<BundleEntry> &entries) {
+  #ifdef _WIN32
+    auto temporary = filename + "." + std::to_string(_getpid()) + ".tmp";
+  #else
+    auto temporary = filename + "." + std::to_string(getpid()) + ".tmp";
+  #endif
+  std::ofstream file(temporary, std::ios::binary);
+  if (!file) { throw std::runtime_error("Could not write binary bundle: " + temporary); }
+
+  // Computes the locations of the fields
+  auto header = std::vector<uint64_t>{kBundleMagic, entries.size()};
+  auto offset = (2 + 2 * kNumFields * entries.size()) * sizeof(uint64_t);
+  for (auto &entry: entries) {
+    for (auto field: EntryFields(entry)) {
+      offset = AlignField(offset);
+      header.push_back(offset);
+      header.push_back(field->size());
+      offset += field->size();
+    }
+  }
+
+  // Writes the data, padding the fields up to the alignment
+  auto padding = std::vector<char>(kAlignment, 0);
+  file.write(reinterpret_cast<const char*>(header.data()), header.size() * sizeof(uint64_t));
+  offset = header.size() * sizeof(uint64_t);
+  for (auto &entry: entries) {
+    for (auto field: EntryFields(entry)) {
+      file.write(padding.data(), AlignField(offset) - offset);
+      file.write(field->data(), field->size());
+      offset = AlignField(offset) + field->size();
+    }
+  }
+  file.close();
+
+  // Moves the complete file into place
+  if (file.fail() || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("Could not write binary bundle: " + filename);
+  }
+}
+
+// =================================================================================================
+} // namespace cltune
@@ -0,0 +1,273 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the generator of dispatch headers (see the header for information about the
+// generated header).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/dispatch_header.h"
+
+#include <algorithm> // std::max, std::transform
+#include <cctype> // std::isalnum, toupper
+#include <fstream> // std::ifstream
+#include <cstdio> // fopen, fprintf
+#include <cstdlib> // std::strtod
+#include <stdexcept> // std::runtime_error
+
+namespace cltune {
+// =================================================================================================
+
+// The start of a generated header: its description, include guard, and namespace
+static std::string HeaderPrologue(const std::string &description, const std::string &guard,
+                                  const std::string &name_space) {
+  return R"(
+// =================================================================================================
+// This file was generated by CLTune )" + description + R"(
+// =================================================================================================
+
+#ifndef )" + guard + R"(
+#define )" + guard + R"(
+
+#include <cstddef>
+#include <string>
+
+namespace )" + name_space + R"( {
+// =================================================================================================
+
+struct Parameter {
+  const char* name;
+  size_t value;
+};
+)";
+}
+
+// The end of a generated header: functions to obtain the parameters of an element of the table,
+// followed by the given lookup of an element
+static std::string HeaderEpilogue(const std::string &guard, const std::string &name_space,
+                                  const std::string &table, const std::string &lookup) {
+  return R"(
+// Compares two strings, also in constant expressions
+constexpr bool Equal(const char* a, const char* b) {
+  return (*a == *b) && (*a == '\0' || Equal(a + 1, b + 1));
+}
+
+// Returns the value of a parameter, or 0 if the configuration does not have it
+constexpr size_t Value(const size_t index, const char* name, const size_t p = 0) {
+  return (p == )" + table + R"([index].num_parameters) ? 0 :
+         Equal()" + table + R"([index].parameters[p].name, name) ?
+         )" + table + R"([index].parameters[p].value : Value(index, name, p + 1);
+}
+
+// Returns the parameters as defines, to be prepended to the kernel source
+inline std::string Defines(const size_t index) {
+  auto defines = std::string{};
+  for (auto p = size_t{0}; p < )" + table + R"([index].num_parameters; ++p) {
+    defines += "#define " + std::string{)" + table + R"([index].parameters[p].name} + " " +
+               std::to_string()" + table + R"([index].parameters[p].value) + "\n";
+  }
+  return defines;
+}
+
+)" + lookup + R"(
+// =================================================================================================
+} // namespace )" + name_space + R"(
+
+// )" + guard + R"(
+#endif
+)";
+}
+
+// The lookup of a configuration in a dispatch header
+const std::string kDispatchGuard = "CLTUNE_DISPATCH_H_";
+const std::string kDispatchNamespace = "cltune_dispatch";
+const std::string kDispatchLookup = R"(constexpr size_t kNumConfigurations =
+    sizeof(kConfigurations) / sizeof(kConfigurations[0]);
+
+// Returns the index of the configuration of a kernel for a device and a problem-size class, or
+// kNumConfigurations if there is none. Usable in constant expressions.
+constexpr size_t Find(const char* kernel, const char* device, const char* size_class,
+                      const size_t i = 0) {
+  return (i == kNumConfigurations) ? kNumConfigurations :
+         (Equal(kConfigurations[i].kernel, kernel) && Equal(kConfigurations[i].device, device) &&
+          Equal(kConfigurations[i].size_class, size_class)) ? i :
+         Find(kernel, device, size_class, i + 1);
+}
+)";
+
+// The selection of an interval in a sweep header: a binary search over the upper bounds of the
+// intervals, i.e. a balanced decision tree on the problem size
+const std::string kSweepLookup = R"(constexpr size_t kNumIntervals =
+    sizeof(kIntervals) / sizeof(kIntervals[0]);
+
+// Returns the index of the interval of a problem size. Usable in constant expressions.
+constexpr size_t Select(const size_t size, const size_t first = 0,
+                        const size_t last = kNumIntervals - 1) {
+  return (first == last) ? first :
+         (size <= kIntervals[(first + last) / 2].max_size) ?
+         Select(size, first, (first + last) / 2) : Select(size, (first + last) / 2 + 1, last);
+}
+)";
+
+// Every entry line starts with this, which is how they are recognized when reading a header back
+const std::string kDispatchEntryStart = "  {\"";
+
+// Removes the characters which would end a string literal
+static std::string Sanitize(const std::string &text) {
+  auto result = std::string{};
+  for (auto character: text) {
+    if (character != '"' && character != '\\' && character != '\n') { result += character; }
+  }
+  return result;
+}
+
+// Writes the name and value of each parameter as initializers of the 'Parameter' structure
+static void WriteParameters(FILE* file, const ParameterRange &parameters) {
+  for (auto p = size_t{0}; p < parameters.size(); ++p) {
+    fprintf(file, "%s{\"%s\", %zu}", (p == 0) ? "" : ", ", Sanitize(parameters[p].first).c_str(),
+            parameters[p].second);
+  }
+}
+
+// =================================================================================================
+
+void AddDispatchEntry(std::vector<DispatchEntry> &entries, const DispatchEntry &entry) {
+  for (auto &existing: entries) {
+    if (existing.kernel == entry.kernel && existing.device == entry.device &&
+        existing.size_class == entry.size_class) {
+      existing = entry;
+      return;
+    }
+  }
+  entries.push_back(entry);
+}
+
+// An entry line consists of string literals and numbers: the kernel, device, size class, time, and
+// number of parameters, followed by the name and value of each parameter
+std::vector<DispatchEntry> ReadDispatchHeader(const std::string &filename) {
+  auto entries = std::vector<DispatchEntry>();
+  std::ifstream file(filename);
+  auto line = std::string{};
+  while (std::getline(file, line)) {
+    if (line.compare(0, kDispatchEntryStart.size(), kDispatchEntryStart) != 0) { continue; }
+    auto strings = std::vector<std::string>();
+    auto numbers = std::vector<double>();
+    for (auto i = size_t{0}; i < line.size(); ++i) {
+      if (line[i] == '"') {
+        auto end = line.find('"', i + 1);
+        if (end == std::string::npos) { break; }
+        strings.push_back(line.substr(i + 1, end - i - 1));
+        i = end;
+      }
+      else if (line[i] >= '0' && line[i] <= '9') {
+        auto end = static_cast<char*>(nullptr);
+        numbers.push_back(std::strtod(line.c_str() + i, &end));
+        i = static_cast<size_t>(end - line.c_str()) - 1;
+      }
+    }
+    if (strings.size() < 3 || numbers.size() < 2 || strings.size() - 3 != numbers.size() - 2) {
+      throw std::runtime_error("Invalid entry in dispatch header " + filename + ": " + line);
+    }
+    auto entry = DispatchEntry{strings[0], strings[1], strings[2],
+                               static_cast<float>(numbers[0]), {}};
+    for (auto p = size_t{3}; p < strings.size(); ++p) {
+      entry.parameters.push_back({strings[p], static_cast<size_t>(numbers[p - 1])});
+    }
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
+// The parameters are stored in an array sized for the configuration with the most parameters
+void WriteDispatchHeader(const std::string &filename, const std::vector<DispatchEntry> &entries) {
+  auto file = fopen(filename.c_str(), "w");
+  if (file == nullptr) { throw std::runtime_error("Could not open dispatch header: " + filename); }
+  auto max_parameters = size_t{1};
+  for (auto &entry: entries) { max_parameters = std::max(max_parameters, entry.parameters.size()); }
+  auto description = std::string{"(PrintDispatchHeader) and holds the best configuration of each\n"
+                                 "// kernel per device and problem-size class. Generating it again "
+                                 "merges new configurations into it."};
+  fprintf(file, "%s\n", HeaderPrologue(description, kDispatchGuard, kDispatchNamespace).c_str());
+  fprintf(file, "struct Configuration {\n");
+  fprintf(file, "  const char* kernel;\n");
+  fprintf(file, "  const char* device;\n");
+  fprintf(file, "  const char* size_class;\n");
+  fprintf(file, "  float time; // Execution time when tuned (ms)\n");
+  fprintf(file, "  size_t num_parameters;\n");
+  fprintf(file, "  Parameter parameters[%zu];\n", max_parameters);
+  fprintf(file, "};\n\n");
+  fprintf(file, "constexpr Configuration kConfigurations[] = {\n");
+  for (auto &entry: entries) {
+    fprintf(file, "%s%s\", \"%s\", \"%s\", %.3ff, %zu, {", kDispatchEntryStart.c_str(),
+            Sanitize(entry.kernel).c_str(), Sanitize(entry.device).c_str(),
+            Sanitize(entry.size_class).c_str(), entry.time, entry.parameters.size());
+    WriteParameters(file, entry.parameters);
+    fprintf(file, "}},\n");
+  }
+  fprintf(file, "};\n%s", HeaderEpilogue(kDispatchGuard, kDispatchNamespace, "kConfigurations",
+                                         kDispatchLookup).c_str());
+  fclose(file);
+}
+
+// The guard and namespace are named after the kernel, such that the headers of multiple kernels can
+// be included together
+void WriteSweepHeader(const std::string &filename, const std::string &kernel,
+                      const std::string &device, const std::vector<SweepInterval> &intervals) {
+  auto file = fopen(filename.c_str(), "w");
+  if (file == nullptr) { throw std::runtime_error("Could not open sweep header: " + filename); }
+  auto name = std::string{};
+  for (auto character: kernel) {
+    name += std::isalnum(static_cast<unsigned char>(character)) ? character : '_';
+  }
+  auto guard = "CLTUNE_SWEEP_" + name + "_H_";
+  std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+  auto name_space = "cltune_sweep_" + name;
+  auto max_parameters = size_t{1};
+  for (auto &interval: intervals) {
+    max_parameters = std::max(max_parameters, interval.configuration.size());
+  }
+  auto description = std::string{"(PrintSweepHeader) and holds the best configuration of a kernel\n"
+                                  "// per interval of problem sizes (inclusive)."};
+  fprintf(file, "%s\n", HeaderPrologue(description, guard, name_space).c_str());
+  fprintf(file, "struct Interval {\n");
+  fprintf(file, "  size_t min_size;\n");
+  fprintf(file, "  size_t max_size;\n");
+  fprintf(file, "  size_t num_parameters;\n");
+  fprintf(file, "  Parameter parameters[%zu];\n", max_parameters);
+  fprintf(file, "};\n\n");
+  fprintf(file, "constexpr const char* kKernel = \"%s\";\n", Sanitize(kernel).c_str());
+  fprintf(file, "constexpr const char* kDevice = \"%s\";\n\n", Sanitize(device).c_str());
+  fprintf(file, "constexpr Interval kIntervals[] = {\n");
+  for (auto &interval: intervals) {
+    fprintf(file, "  {%zuULL, %zuULL, %zu, {", interval.min_size, interval.max_size,
+            interval.configuration.size());
+    WriteParameters(file, interval.configuration);
+    fprintf(file, "}},\n");
+  }
+  fprintf(file, "};\n%s", HeaderEpilogue(guard, name_space, "kIntervals", kSweepLookup).c_str());
+  fclose(file);
+}
+
+// =================================================================================================
+} // namespace cltune
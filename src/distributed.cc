@@ -0,0 +1,546 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the Coordinator and Worker classes (see the header for information about
+// these classes). Sockets are only supported on POSIX systems.
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/distributed.h"
+
+// For output formatting messages
+#include "internal/tuner_impl.h"
+
+#include <deque> // std::deque
+#include <sstream> // std::istringstream
+#include <fstream> // std::ifstream
+#include <cstring> // std::strncpy
+#include <cstdio> // snprintf
+#include <cstdlib> // getenv
+#include <limits> // std::numeric_limits
+#include <algorithm> // std::find, std::max
+
+#ifndef _WIN32
+  #include <unistd.h> // close, unlink, sleep, usleep
+  #include <signal.h> // kill
+  #include <poll.h> // poll
+  #include <netdb.h> // getaddrinfo
+  #include <spawn.h> // posix_spawn
+  #include <sys/types.h>
+  #include <sys/wait.h> // waitpid
+  #include <sys/socket.h> // socket, bind, listen, accept, connect, send, recv
+  #include <sys/un.h> // sockaddr_un
+  extern char **environ;
+#endif
+
+namespace cltune {
+// =================================================================================================
+
+#ifndef _WIN32
+
+// Suppresses SIGPIPE when a lost peer is written to, the error is reported through the return value
+#ifdef MSG_NOSIGNAL
+  constexpr auto kSendFlags = MSG_NOSIGNAL;
+#else
+  constexpr auto kSendFlags = 0;
+#endif
+
+// Splits an address of the form "tcp://host:port" or "unix:/path" into its components
+static void ParseAddress(const std::string &address, bool &is_unix, std::string &host,
+                         std::string &port) {
+  if (address.compare(0, 7, "unix://") == 0) { is_unix = true; host = address.substr(7); }
+  else if (address.compare(0, 5, "unix:") == 0) { is_unix = true; host = address.substr(5); }
+  else if (address.compare(0, 6, "tcp://") == 0) {
+    is_unix = false;
+    auto host_port = address.substr(6);
+    auto colon = host_port.rfind(':');
+    if (colon == std::string::npos) { throw std::runtime_error("Missing port in: "+address); }
+    host = host_port.substr(0, colon);
+    port = host_port.substr(colon + 1);
+  }
+  else {
+    throw std::runtime_error("Invalid address (expected tcp://host:port or unix:/path): "+address);
+  }
+}
+
+// Creates a socket for an address which is either bound and listening or connected. Returns -1 if
+// connecting fails, such that the caller can retry. Failing to listen throws an exception.
+static int OpenSocket(const std::string &address, const bool listening) {
+  auto is_unix = false;
+  auto host = std::string{};
+  auto port = std::string{};
+  ParseAddress(address, is_unix, host, port);
+
+  // Unix-domain sockets: the host is the path in the file-system
+  if (is_unix) {
+    auto socket_address = sockaddr_un{};
+    if (host.size() >= sizeof(socket_address.sun_path)) {
+      throw std::runtime_error("Unix-domain socket path too long: "+host);
+    }
+    socket_address.sun_family = AF_UNIX;
+    std::strncpy(socket_address.sun_path, host.c_str(), sizeof(socket_address.sun_path) - 1);
+    auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) { throw std::runtime_error("Could not create a Unix-domain socket"); }
+    auto socket_pointer = reinterpret_cast<sockaddr*>(&socket_address);
+    if (listening) {
+      unlink(host.c_str());
+      if (bind(fd, socket_pointer, sizeof(socket_address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not listen on: "+address);
+      }
+      return fd;
+    }
+    if (connect(fd, socket_pointer, sizeof(socket_address)) != 0) { close(fd); return -1; }
+    return fd;
+  }
+
+  // TCP sockets: resolves the host (a '*' host listens on all interfaces)
+  auto hints = addrinfo{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = (listening) ? AI_PASSIVE : 0;
+  auto node = (host == "*" || host.empty()) ? nullptr : host.c_str();
+  addrinfo* addresses = nullptr;
+  if (getaddrinfo(node, port.c_str(), &hints, &addresses) != 0) {
+    if (listening) { throw std::runtime_error("Could not resolve: "+address); }
+    return -1;
+  }
+  auto fd = -1;
+  for (auto info = addresses; info != nullptr; info = info->ai_next) {
+    fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    if (fd < 0) { continue; }
+    if (listening) {
+      auto reuse = 1;
+      setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+      if (bind(fd, info->ai_addr, info->ai_addrlen) == 0 && listen(fd, SOMAXCONN) == 0) { break; }
+    }
+    else if (connect(fd, info->ai_addr, info->ai_addrlen) == 0) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(addresses);
+  if (fd < 0 && listening) { throw std::runtime_error("Could not listen on: "+address); }
+  return fd;
+}
+
+// =================================================================================================
+
+// Uses the temporary directory and the process ID to create a unique path
+std::string PrivateAddress() {
+  auto directory = getenv("TMPDIR");
+  auto path = std::string{(directory != nullptr) ? directory : "/tmp"};
+  return "unix:" + path + "/cltune_" + std::to_string(getpid()) + ".socket";
+}
+
+// =================================================================================================
+
+// Takes ownership of an open socket
+Connection::Connection(const int socket):
+    socket_(socket),
+    buffer_(),
+    lines_() {
+}
+
+// Closes the socket
+Connection::~Connection() {
+  close(socket_);
+}
+
+// Sends a line, handling partial writes
+bool Connection::SendLine(const std::string &line) {
+  auto message = line + "\n";
+  auto sent = size_t{0};
+  while (sent < message.size()) {
+    auto bytes = send(socket_, message.data() + sent, message.size() - sent, kSendFlags);
+    if (bytes <= 0) { return false; }
+    sent += static_cast<size_t>(bytes);
+  }
+  return true;
+}
+
+// Receives once and returns all complete lines received so far
+std::vector<std::string> Connection::ReceiveLines(bool &closed) {
+  char data[4096];
+  auto bytes = recv(socket_, data, sizeof(data), 0);
+  closed = (bytes <= 0);
+  if (bytes > 0) { buffer_.append(data, static_cast<size_t>(bytes)); }
+  auto newline = buffer_.find('\n');
+  while (newline != std::string::npos) {
+    lines_.push_back(buffer_.substr(0, newline));
+    buffer_.erase(0, newline + 1);
+    newline = buffer_.find('\n');
+  }
+  auto lines = lines_;
+  lines_.clear();
+  return lines;
+}
+
+// Receives until a complete line is available
+bool Connection::ReceiveLine(std::string &line) {
+  while (lines_.empty()) {
+    auto closed = false;
+    lines_ = ReceiveLines(closed);
+    if (closed && lines_.empty()) { return false; }
+  }
+  line = lines_.front();
+  lines_.erase(lines_.begin());
+  return true;
+}
+
+// =================================================================================================
+
+// Starts listening: workers can connect from now on
+Coordinator::Coordinator(const std::string &address):
+    address_(address),
+    listener_(OpenSocket(address, true)),
+    local_listener_(-1),
+    sequence_(0),
+    max_losses_(kMaxLosses),
+    timeout_ms_(0.0f),
+    workers_(),
+    local_workers_() {
+}
+
+// Tells the workers that tuning has finished and waits for the local ones to exit. The listener is
+// closed first, such that workers which have not been accepted yet are disconnected as well. Local
+// workers which are still trying to connect after the timeout are killed.
+Coordinator::~Coordinator() {
+  for (auto &worker: workers_) { worker.connection->SendLine("DONE"); }
+  workers_.clear();
+  close(listener_);
+  if (local_listener_ >= 0 && local_listener_ != listener_) {
+    close(local_listener_);
+    unlink(PrivateAddress().substr(5).c_str());
+  }
+  for (auto waited = 0; waited < kShutdownTimeoutMs && LocalWorkersAlive(); waited += 100) {
+    usleep(100 * 1000);
+  }
+  for (auto &pid: local_workers_) { kill(pid, SIGKILL); waitpid(pid, nullptr, 0); }
+  auto is_unix = false;
+  auto host = std::string{};
+  auto port = std::string{};
+  ParseAddress(address_, is_unix, host, port);
+  if (is_unix) { unlink(host.c_str()); }
+}
+
+// Re-executes the current program with the same command-line arguments, but now with the worker
+// environment variable set. The local workers connect through a private socket (the listener
+// itself in case of isolated execution), which is how their connections are recognized.
+void Coordinator::SpawnLocalWorkers(const size_t num_workers) {
+  auto worker_address = PrivateAddress();
+  if (local_listener_ < 0) {
+    local_listener_ = (address_ == worker_address) ? listener_ : OpenSocket(worker_address, true);
+  }
+
+  // Retrieves the command-line arguments of the current process
+  auto cmdline_file = std::ifstream("/proc/self/cmdline");
+  if (cmdline_file.fail()) { throw std::runtime_error("Local workers require /proc/self"); }
+  auto arguments = std::vector<std::string>();
+  auto argument = std::string{};
+  while (std::getline(cmdline_file, argument, '\0')) { arguments.push_back(argument); }
+  auto argv = std::vector<char*>();
+  for (auto &item: arguments) { argv.push_back(&item[0]); }
+  argv.push_back(nullptr);
+
+  // Sets-up the environment of the workers
+  auto variable = std::string{kWorkerAddressVariable} + "=" + worker_address;
+  auto envp = std::vector<char*>{&variable[0]};
+  for (auto env = environ; *env != nullptr; ++env) {
+    if (std::string{*env}.compare(0, variable.find('=') + 1, variable, 0,
+                                  variable.find('=') + 1) != 0) {
+      envp.push_back(*env);
+    }
+  }
+  envp.push_back(nullptr);
+
+  // Launches the workers
+  for (auto w = size_t{0}; w < num_workers; ++w) {
+    auto pid = pid_t{0};
+    if (posix_spawn(&pid, "/proc/self/exe", nullptr, nullptr, argv.data(), envp.data()) != 0) {
+      throw std::runtime_error("Could not spawn a local worker");
+    }
+    local_workers_.push_back(pid);
+  }
+}
+
+// Sets the watchdog settings
+void Coordinator::SetWatchdog(const size_t max_losses, const float timeout_ms) {
+  max_losses_ = std::max(max_losses, size_t{1});
+  timeout_ms_ = timeout_ms;
+}
+
+// Accepts a new connection on a listening socket
+void Coordinator::AcceptWorker(const int listener) {
+  auto fd = accept(listener, nullptr, nullptr);
+  if (fd < 0) { return; }
+  auto worker = WorkerState{std::unique_ptr<Connection>(new Connection(fd)), "unknown", 0,
+                            listener == local_listener_, false, 0,
+                            std::chrono::steady_clock::now()};
+  workers_.push_back(std::move(worker));
+}
+
+// Kills and reaps a lost local worker to find out what happened to it, then starts a new one
+std::string Coordinator::DropWorker(const WorkerState &worker) {
+  auto local = std::find(local_workers_.begin(), local_workers_.end(), worker.pid);
+  if (!worker.local || worker.pid == 0 || local == local_workers_.end()) {
+    return "connection to worker lost";
+  }
+  local_workers_.erase(local);
+  auto status = 0;
+  kill(worker.pid, SIGKILL);
+  waitpid(worker.pid, &status, 0);
+  SpawnLocalWorkers(1);
+  if (WIFSIGNALED(status) && WTERMSIG(status) != SIGKILL) {
+    return "worker crashed with signal " + std::to_string(WTERMSIG(status));
+  }
+  if (WIFEXITED(status)) {
+    return "worker exited with code " + std::to_string(WEXITSTATUS(status));
+  }
+  return "worker was killed";
+}
+
+// Reaps the local workers which have exited
+bool Coordinator::LocalWorkersAlive() {
+  auto alive = std::vector<int>();
+  for (auto &pid: local_workers_) {
+    if (waitpid(pid, nullptr, WNOHANG) == 0) { alive.push_back(pid); }
+  }
+  local_workers_ = alive;
+  return !local_workers_.empty();
+}
+
+// Hands out the configurations of the batch to idle workers and collects their results. When a
+// worker is lost, its configuration goes back to the front of the queue, unless it was lost too
+// often already: then it is most likely the cause itself and it is marked as failed.
+std::vector<WorkerResult> Coordinator::Evaluate(const size_t kernel_id,
+                                                const std::vector<KernelInfo::Configuration> &batch) {
+  auto results = std::vector<WorkerResult>(batch.size());
+  auto losses = std::vector<size_t>(batch.size(), 0);
+  auto pending = std::deque<size_t>();
+  for (auto i = size_t{0}; i < batch.size(); ++i) { pending.push_back(i); }
+  auto first_sequence = sequence_;
+  sequence_ += batch.size();
+  auto num_done = size_t{0};
+  while (num_done < batch.size()) {
+
+    // Assigns work to the idle workers
+    for (auto &worker: workers_) {
+      if (worker.busy || pending.empty()) { continue; }
+      auto job = pending.front();
+      auto message = "RUN " + std::to_string(first_sequence + job) + " " +
+                     std::to_string(kernel_id) + " " + std::to_string(batch[job].size());
+      for (auto &setting: batch[job]) {
+        message += " " + setting.name + " " + setting.GetValueString();
+      }
+      if (worker.connection->SendLine(message)) {
+        pending.pop_front();
+        worker.busy = true;
+        worker.job = job;
+        worker.start = std::chrono::steady_clock::now();
+      }
+    }
+
+    // Waits for activity on any of the sockets
+    auto fds = std::vector<pollfd>{pollfd{listener_, POLLIN, 0}};
+    for (auto &worker: workers_) { fds.push_back(pollfd{worker.connection->socket(), POLLIN, 0}); }
+    auto local_index = fds.size();
+    if (local_listener_ >= 0 && local_listener_ != listener_) {
+      fds.push_back(pollfd{local_listener_, POLLIN, 0});
+    }
+    auto poll_interval_ms = kPollIntervalMs;
+    if (timeout_ms_ > 0.0f) {
+      poll_interval_ms = std::min(poll_interval_ms, std::max(1, static_cast<int>(timeout_ms_ / 10)));
+    }
+    poll(fds.data(), fds.size(), poll_interval_ms);
+
+    // Processes messages from the workers and detects lost workers
+    auto connected = std::vector<WorkerState>();
+    auto now = std::chrono::steady_clock::now();
+    for (auto w = size_t{0}; w < workers_.size(); ++w) {
+      auto &worker = workers_[w];
+      auto closed = false;
+      auto reason = std::string{};
+      if (fds[w + 1].revents != 0) {
+        for (auto &line: worker.connection->ReceiveLines(closed)) {
+          auto stream = std::istringstream(line);
+          auto command = std::string{};
+          stream >> command;
+          if (command == "HELLO") {
+            stream >> worker.pid;
+            std::getline(stream >> std::ws, worker.name);
+          }
+          else if (command == "RESULT") {
+            auto sequence = size_t{0};
+            auto status = 0;
+            auto result = WorkerResult{0.0f, 0, false, std::string{}, false, 0,
+                                       std::vector<float>(kNumTimings), 0.0f, 0.0f, 0.0f, 0};
+            stream >> sequence >> result.time >> result.threads >> result.peak_memory;
+            for (auto &timing: result.timings) { stream >> timing; }
+            stream >> result.energy >> result.power >> result.compile_time >> result.local_memory;
+            stream >> status;
+            std::getline(stream >> std::ws, result.failure_reason);
+            result.status = (status == 1);
+            result.timed_out = (status == 2);
+            if (worker.busy && sequence == first_sequence + worker.job) {
+              results[worker.job] = result;
+              worker.busy = false;
+              ++num_done;
+            }
+          }
+        }
+      }
+
+      // The watchdog: a worker which takes too long on a configuration is considered lost
+      auto elapsed = std::chrono::duration<float, std::milli>(now - worker.start).count();
+      auto timed_out = (!closed && worker.busy && timeout_ms_ > 0.0f && elapsed > timeout_ms_);
+      if (timed_out) {
+        closed = true;
+        reason = "timed out after " + std::to_string(static_cast<size_t>(elapsed)) + " ms";
+      }
+      if (closed) {
+        auto drop_reason = DropWorker(worker);
+        if (reason.empty()) { reason = drop_reason; }
+        fprintf(stdout, "%s Lost worker '%s': %s\n", TunerImpl::kMessageWarning.c_str(),
+                worker.name.c_str(), reason.c_str());
+        if (worker.busy) {
+          if (++losses[worker.job] >= max_losses_) {
+            auto time = (timed_out) ? timeout_ms_ : std::numeric_limits<float>::max();
+            results[worker.job] = WorkerResult{time, 0, false, reason, timed_out, 0,
+                                               std::vector<float>(kNumTimings), 0.0f, 0.0f,
+                                               0.0f, 0};
+            ++num_done;
+          }
+          else {
+            pending.push_front(worker.job);
+          }
+        }
+        continue;
+      }
+      connected.push_back(std::move(worker));
+    }
+    workers_ = std::move(connected);
+
+    // Accepts newly connected workers
+    if (fds[0].revents & POLLIN) { AcceptWorker(listener_); }
+    if (local_index < fds.size() && (fds[local_index].revents & POLLIN)) {
+      AcceptWorker(local_listener_);
+    }
+
+    // Avoids waiting forever when the local workers have all gone
+    if (workers_.empty() && !local_workers_.empty() && !LocalWorkersAlive()) {
+      throw std::runtime_error("All local workers have exited");
+    }
+  }
+  return results;
+}
+
+// =================================================================================================
+
+// Connects to the coordinator, retrying for a while in case it is not listening yet
+Worker::Worker(const std::string &address, const std::string &device_name) {
+  auto fd = -1;
+  for (auto attempt = 0; attempt < kConnectAttempts && fd < 0; ++attempt) {
+    fd = OpenSocket(address, false);
+    if (fd < 0) { sleep(1); }
+  }
+  if (fd < 0) { throw std::runtime_error("Could not connect to coordinator at: "+address); }
+  connection_.reset(new Connection(fd));
+  connection_->SendLine("HELLO " + std::to_string(getpid()) + " " + device_name);
+}
+
+// Parses the next "RUN" message
+bool Worker::Receive(size_t &sequence, size_t &kernel_id,
+                     KernelInfo::Configuration &configuration) {
+  auto line = std::string{};
+  if (!connection_->ReceiveLine(line)) { return false; }
+  auto stream = std::istringstream(line);
+  auto command = std::string{};
+  auto num_settings = size_t{0};
+  stream >> command >> sequence >> kernel_id >> num_settings;
+  if (command != "RUN") { return false; }
+  configuration.clear();
+  for (auto s = size_t{0}; s < num_settings; ++s) {
+    auto setting = KernelInfo::Setting{std::string{}, 0};
+    stream >> setting.name >> setting.value;
+    configuration.push_back(setting);
+  }
+  return true;
+}
+
+// Sends the result in the "RESULT" message. The times are printed such that they round-trip
+// exactly.
+void Worker::Send(const size_t sequence, const WorkerResult &result) {
+  char time[32];
+  snprintf(time, sizeof(time), "%.9g", result.time);
+  auto timings = std::string{};
+  for (auto t = size_t{0}; t < kNumTimings; ++t) {
+    char timing[32];
+    snprintf(timing, sizeof(timing), "%.9g ", t < result.timings.size() ? result.timings[t] : 0.0f);
+    timings += timing;
+  }
+  char energy[96];
+  snprintf(energy, sizeof(energy), "%.9g %.9g %.9g %zu ", result.energy, result.power,
+           result.compile_time, result.local_memory);
+  connection_->SendLine("RESULT " + std::to_string(sequence) + " " + time + " " +
+                        std::to_string(result.threads) + " " +
+                        std::to_string(result.peak_memory) + " " + timings + energy +
+                        (result.timed_out ? "2" : (result.status ? "1" : "0")) + " " +
+                        result.failure_reason.substr(0, result.failure_reason.find('\n')));
+}
+
+// =================================================================================================
+
+#else // Windows: sockets are not supported
+
+std::string PrivateAddress() { return std::string{}; }
+Connection::Connection(const int socket): socket_(socket) { }
+Connection::~Connection() { }
+bool Connection::SendLine(const std::string &) { return false; }
+std::vector<std::string> Connection::ReceiveLines(bool &closed) { closed = true; return {}; }
+bool Connection::ReceiveLine(std::string &) { return false; }
+Coordinator::Coordinator(const std::string &) {
+  throw std::runtime_error("Distributed tuning is not supported on Windows");
+}
+Coordinator::~Coordinator() { }
+void Coordinator::SpawnLocalWorkers(const size_t) { }
+void Coordinator::SetWatchdog(const size_t, const float) { }
+void Coordinator::AcceptWorker(const int) { }
+std::string Coordinator::DropWorker(const WorkerState &) { return std::string{}; }
+bool Coordinator::LocalWorkersAlive() { return false; }
+std::vector<WorkerResult> Coordinator::Evaluate(const size_t,
+                                                const std::vector<KernelInfo::Configuration> &) {
+  return {};
+}
+Worker::Worker(const std::string &, const std::string &) {
+  throw std::runtime_error("Distributed tuning is not supported on Windows");
+}
+bool Worker::Receive(size_t &, size_t &, KernelInfo::Configuration &) { return false; }
+void Worker::Send(const size_t, const WorkerResult &) { }
+
+#endif
+
+// =================================================================================================
+} // namespace cltune
@@ -0,0 +1,104 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the RaplMeter class (see the header for information about the class).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/energy_meter.h"
+
+#include <fstream> // std::ifstream
+#include <algorithm> // std::count
+#include <stdexcept> // std::runtime_error
+
+#ifdef __linux__
+  #include <dirent.h> // opendir, readdir, closedir
+#endif
+
+namespace cltune {
+// =================================================================================================
+
+const std::string RaplMeter::kPowercapDirectory = "/sys/class/powercap";
+
+// Reads a single number from a file, returns false if that fails
+static bool ReadValue(const std::string &filename, double &value) {
+  auto file = std::ifstream(filename);
+  return static_cast<bool>(file >> value);
+}
+
+// =================================================================================================
+
+// The packages are the zones named '<driver>:<package>'. Their sub-zones (e.g. the cores or the
+// DRAM, named '<driver>:<package>:<zone>') are part of the package and are not counted. The MMIO
+// variant of the interface reports the same package energy and is skipped.
+RaplMeter::RaplMeter():
+    zones_() {
+  #ifdef __linux__
+    auto directory = opendir(kPowercapDirectory.c_str());
+    if (directory == nullptr) {
+      throw std::runtime_error("No energy counters found: " + kPowercapDirectory + " is missing");
+    }
+    auto unreadable = std::string{};
+    while (auto entry = readdir(directory)) {
+      auto name = std::string{entry->d_name};
+      auto driver = name.substr(0, name.find(':'));
+      auto is_package = (std::count(name.begin(), name.end(), ':') == 1);
+      if (!is_package || driver.find("mmio") != std::string::npos) { continue; }
+      auto path = kPowercapDirectory + "/" + name + "/";
+      auto zone = Zone{path + "energy_uj", 0.0, 0.0, 0.0};
+      if (!ReadValue(path + "max_energy_range_uj", zone.range) ||
+          !ReadValue(zone.filename, zone.last)) {
+        unreadable = zone.filename;
+        continue;
+      }
+      zone.range += 1.0;
+      zones_.push_back(zone);
+    }
+    closedir(directory);
+    if (zones_.empty() && !unreadable.empty()) {
+      throw std::runtime_error("Could not read the energy counter " + unreadable +
+                               " (root permissions are usually required)");
+    }
+  #endif
+  if (zones_.empty()) {
+    throw std::runtime_error("No energy counters found (requires Linux powercap/RAPL)");
+  }
+}
+
+// A counter which is lower than before has wrapped around
+double RaplMeter::Read() {
+  auto energy = 0.0;
+  for (auto &zone: zones_) {
+    auto value = zone.last;
+    if (ReadValue(zone.filename, value)) {
+      zone.total += (value >= zone.last) ? value - zone.last : value + zone.range - zone.last;
+      zone.last = value;
+    }
+    energy += zone.total;
+  }
+  return energy * 1.0e-6;
+}
+
+// =================================================================================================
+} // namespace cltune
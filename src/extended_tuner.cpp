@@ -194,6 +194,45 @@ template void PUBLIC_API ExtendedTuner::addArgumentScalarReference<double>(const
 template void PUBLIC_API ExtendedTuner::addArgumentScalarReference<float2>(const float2 argument);
 template void PUBLIC_API ExtendedTuner::addArgumentScalarReference<double2>(const double2 argument);
 
+template <typename T> void ExtendedTuner::addSharedBuffer(const std::string& name, const std::vector<T>& source)
+{
+    basicTuner->AddSharedBuffer(name, source);
+}
+
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<short>(const std::string&, const std::vector<short>&);
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<int>(const std::string&, const std::vector<int>&);
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<size_t>(const std::string&, const std::vector<size_t>&);
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<half>(const std::string&, const std::vector<half>&);
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<float>(const std::string&, const std::vector<float>&);
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<double>(const std::string&, const std::vector<double>&);
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<float2>(const std::string&, const std::vector<float2>&);
+template void PUBLIC_API ExtendedTuner::addSharedBuffer<double2>(const std::string&, const std::vector<double2>&);
+
+void ExtendedTuner::releaseSharedBuffer(const std::string& name)
+{
+    basicTuner->ReleaseSharedBuffer(name);
+}
+
+void ExtendedTuner::addArgumentInputShared(const size_t id, const std::string& name)
+{
+    basicTuner->AddArgumentInputShared(id, name);
+}
+
+void ExtendedTuner::addArgumentOutputShared(const size_t id, const std::string& name)
+{
+    basicTuner->AddArgumentOutputShared(id, name);
+}
+
+void ExtendedTuner::addArgumentInputSharedReference(const std::string& name)
+{
+    basicTuner->AddArgumentInputSharedReference(name);
+}
+
+void ExtendedTuner::addArgumentOutputSharedReference(const std::string& name)
+{
+    basicTuner->AddArgumentOutputSharedReference(name);
+}
+
 // ==================================================================================================================================================
 // Additional settings methods
 
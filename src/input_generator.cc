@@ -0,0 +1,169 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the source of the input generator kernel (see the header for information
+// about the kernel).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/input_generator.h"
+
+#include <stdexcept> // std::runtime_error
+#include <cstdio> // snprintf
+
+namespace cltune {
+// =================================================================================================
+
+// The generator kernel, valid as OpenCL and as CUDA source. Each thread computes values with a
+// stride of the total number of threads. Random numbers are obtained by hashing the seed and the
+// index of the value with the finalizer of the SplitMix64 generator: the upper bits of the result
+// form a uniform number in [0, 1). Normal numbers use the Box-Muller transform of two of these.
+const std::string kGeneratorSource = R"(
+#ifdef __OPENCL_VERSION__
+  #if USE_DOUBLE
+    #pragma OPENCL EXTENSION cl_khr_fp64: enable
+  #endif
+  #define KERNEL __kernel
+  #define DEVICE
+  #define GLOBAL __global
+  #define GLOBAL_ID get_global_id(0)
+  #define GLOBAL_SIZE get_global_size(0)
+  #define FLOAT_AS_UINT(x) as_uint(x)
+  typedef ulong uint64;
+#else
+  #define KERNEL extern "C" __global__
+  #define DEVICE __device__
+  #define GLOBAL
+  #define GLOBAL_ID (blockIdx.x * blockDim.x + threadIdx.x)
+  #define GLOBAL_SIZE (gridDim.x * blockDim.x)
+  #define FLOAT_AS_UINT(x) __float_as_uint(x)
+  typedef unsigned long long uint64;
+#endif
+
+#if USE_DOUBLE
+  typedef double real;
+  #define RANDOM_BITS 53
+#else
+  typedef float real;
+  #define RANDOM_BITS 24
+#endif
+
+DEVICE uint64 Mix(uint64 x) {
+  x += 0x9E3779B97F4A7C15UL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9UL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBUL;
+  return x ^ (x >> 31);
+}
+
+DEVICE real Uniform(const uint64 seed, const uint64 counter) {
+  const uint64 bits = Mix(seed ^ Mix(counter)) >> (64 - RANDOM_BITS);
+  return (real)bits / (real)((uint64)1 << RANDOM_BITS);
+}
+
+// Conversion to half-precision by truncation, with overflows set to infinity
+#if USE_HALF
+DEVICE unsigned short FloatToHalf(const float value) {
+  const unsigned int bits = FLOAT_AS_UINT(value);
+  const unsigned short sign = (unsigned short)((bits >> 16) & 0x8000);
+  const int exponent = (int)((bits >> 23) & 0xFF) - 127 + 15;
+  if (exponent <= 0) { return sign; }
+  if (exponent >= 31) { return (unsigned short)(sign | 0x7C00); }
+  return (unsigned short)(sign | (exponent << 10) | ((bits & 0x7FFFFF) >> 13));
+}
+#endif
+
+// Distributions: 0 = uniform, 1 = normal, 2 = constant, 3 = iota, 4 = sparse
+KERNEL void GenerateInput(GLOBAL STORE_TYPE* buffer, const uint64 size, const int distribution,
+                          const real first, const real second, const real density,
+                          const uint64 seed) {
+  for (uint64 i = GLOBAL_ID; i < size; i += GLOBAL_SIZE) {
+    const uint64 element = i / COMPONENTS;
+    real value = (real)0;
+    if (distribution == 0) {
+      value = first + Uniform(seed, 2 * i) * (second - first);
+    }
+    else if (distribution == 1) {
+      const real radius = sqrt((real)-2 * log((real)1 - Uniform(seed, 2 * i)));
+      value = first + second * radius * cos((real)6.283185307179586 * Uniform(seed, 2 * i + 1));
+    }
+    else if (distribution == 2) {
+      value = first;
+    }
+    else if (distribution == 3) {
+      #if INTEGER
+        buffer[i] = (STORE_TYPE)first + (STORE_TYPE)element * (STORE_TYPE)second;
+        continue;
+      #else
+        value = (i % COMPONENTS != 0) ? (real)0 : first + (real)element * second;
+      #endif
+    }
+    else if (Uniform(~seed, element) < density) {
+      value = first + Uniform(seed, 2 * i) * (second - first);
+    }
+    #if USE_HALF
+      buffer[i] = FloatToHalf(value);
+    #elif INTEGER
+      buffer[i] = (STORE_TYPE)floor(value);
+    #else
+      buffer[i] = value;
+    #endif
+  }
+}
+)";
+
+// =================================================================================================
+
+// Prepends the definitions for the data-type to the source
+std::string GeneratorSource(const MemType type) {
+  auto store_type = std::string{};
+  auto components = 1;
+  auto option = std::string{};
+  switch (type) {
+    case MemType::kShort: store_type = "short"; option = "INTEGER"; break;
+    case MemType::kInt: store_type = "int"; option = "INTEGER"; break;
+    case MemType::kSizeT: store_type = "uint64"; option = "INTEGER"; break;
+    case MemType::kHalf: store_type = "unsigned short"; option = "USE_HALF"; break;
+    case MemType::kFloat: store_type = "float"; break;
+    case MemType::kDouble: store_type = "double"; option = "USE_DOUBLE"; break;
+    case MemType::kFloat2: store_type = "float"; components = 2; break;
+    case MemType::kDouble2: store_type = "double"; option = "USE_DOUBLE"; components = 2; break;
+    default: throw std::runtime_error("Unsupported data-type for generated inputs");
+  }
+  auto definitions = "#define STORE_TYPE " + store_type + "\n" +
+                     "#define COMPONENTS " + std::to_string(components) + "\n";
+  if (!option.empty()) { definitions += "#define " + option + " 1\n"; }
+  return definitions + kGeneratorSource;
+}
+
+// Includes all parameters at full precision
+std::string GeneratorDescription(const InputGenerator &generator) {
+  char description[256];
+  snprintf(description, sizeof(description), "%d %a %a %a %llu",
+           static_cast<int>(generator.distribution), generator.first, generator.second,
+           generator.density, static_cast<unsigned long long>(generator.seed));
+  return std::string{description};
+}
+
+// =================================================================================================
+} // namespace cltune
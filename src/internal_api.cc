@@ -30,9 +30,17 @@
 
 // And the implemenation (Pimpl idiom)
 #include "internal/tuner_impl.h"
+#include "internal/input_generator.h"
+#include "internal/trace.h"
+#include "internal/dispatch_header.h"
+#include "internal/binary_bundle.h"
+#include "internal/warm_start.h"
 
 #include <iostream> // FILE
+#include <algorithm> // std::sort, std::unique
+#include <fstream> // std::ifstream
 #include <limits> // std::numeric_limits
+#include <utility> // std::move
 
 namespace cltune {
 // =================================================================================================
@@ -88,10 +96,21 @@ void Tuner::SetReferenceFromString(const std::string &source, const std::string
                                    const IntRange &global, const IntRange &local) {
   pimpl->has_reference_ = true;
   pimpl->reference_kernel_.reset(new KernelInfo(kernel_name, source, pimpl->device()));
+  pimpl->reference_arguments_.clear();
+  pimpl->reference_function_ = nullptr;
   pimpl->reference_kernel_->set_global_base(global);
   pimpl->reference_kernel_->set_local_base(local);
 }
 
+// Sets a host function as the reference
+void Tuner::SetReferenceFunction(ReferenceFunction function) {
+  if (!function) { throw std::runtime_error("Invalid reference function"); }
+  pimpl->has_reference_ = true;
+  pimpl->reference_kernel_.reset();
+  pimpl->reference_arguments_.clear();
+  pimpl->reference_function_ = function;
+}
+
 // =================================================================================================
 
 // Adds parameters for a kernel to tune. Also checks whether this parameter already exists.
@@ -147,6 +166,26 @@ void Tuner::SetMultirunKernelIterations(const size_t id, const std::string &para
   }
 }
 
+// Sets the parameters for the number of chunks and chunks in flight of a streamed kernel. Both have
+// to be positive, the number of chunks furthermore has to divide the sizes of the arguments.
+void Tuner::SetStreamingParameters(const size_t id, const std::string &chunks_parameter,
+                                   const std::string &in_flight_parameter) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  for (auto &parameter_name : {chunks_parameter, in_flight_parameter}) {
+    if (!pimpl->kernels_[id].ParameterExists(parameter_name)) {
+      throw std::runtime_error("Invalid parameter name");
+    }
+  }
+  for (auto &parameter : pimpl->kernels_[id].parameters()) {
+    if (parameter.name == chunks_parameter || parameter.name == in_flight_parameter) {
+      for (auto value : parameter.values) {
+        if (value < 1) { throw std::runtime_error("Invalid number of chunks"); }
+      }
+    }
+  }
+  pimpl->kernels_[id].set_streaming(chunks_parameter, in_flight_parameter);
+}
+
 // Adds a contraint to the list of constraints for a particular kernel. First checks whether the
 // kernel exists and whether the parameters exist.
 void Tuner::AddConstraint(const size_t id, ConstraintFunction valid_if,
@@ -175,15 +214,120 @@ void Tuner::SetLocalMemoryUsage(const size_t id, LocalMemoryFunction amount,
 
 // =================================================================================================
 
+// Selects host or device memory for the argument buffers
+void Tuner::UseZeroCopyBuffers(const bool enabled) {
+  pimpl->buffer_memory_ = (enabled) ? BufferMemory::kHost : BufferMemory::kDevice;
+}
+
+// Sets the device memory budget (0 means no limit other than the device's memory size)
+void Tuner::SetDeviceMemoryBudget(const size_t bytes) {
+  pimpl->memory_budget_ = bytes;
+}
+
+// Sets the timing metric
+void Tuner::SetTimingMetric(const TimingMetric metric) {
+  pimpl->timing_metric_ = metric;
+}
+
+// Sets the number of runs per configuration
+void Tuner::SetNumRuns(const size_t num_runs) {
+  if (num_runs == 0) { throw std::runtime_error("At least one run is required"); }
+  pimpl->num_runs_ = num_runs;
+}
+
+// Sets the statistic over the runs
+void Tuner::SetRunStatistic(const RunStatistic statistic, const double parameter) {
+  if (statistic == RunStatistic::kPercentile && (parameter <= 0.0 || parameter > 100.0)) {
+    throw std::runtime_error("The percentile should be in (0, 100]");
+  }
+  pimpl->run_statistic_ = statistic;
+  pimpl->run_statistic_parameter_ = parameter;
+}
+
+// Sets the number of background threads
+void Tuner::SetBackgroundLoad(const size_t num_threads) {
+  pimpl->background_threads_ = num_threads;
+}
+
+// Sets the drift sentinel of a kernel
+void Tuner::SetDriftSentinel(const size_t id, const ParameterRange &baseline, const size_t interval,
+                             const double tolerance, const DriftAction action) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  if (interval == 0) { throw std::runtime_error("The interval of the drift sentinel is zero"); }
+  auto configuration = KernelInfo::Configuration();
+  for (auto &parameter: baseline) {
+    configuration.push_back(KernelInfo::Setting{parameter.first, parameter.second});
+  }
+  pimpl->drift_sentinels_[id] = TunerImpl::DriftSentinel{configuration, interval, tolerance,
+                                                         action, 0.0f};
+}
+
+// Retrieves the drift events of all tuning so far
+std::vector<DriftEvent> Tuner::GetDriftEvents() const {
+  return pimpl->drift_events_;
+}
+
+// Enables or disables the hardware counters. The counters are tried once, such that a lack of
+// support or permissions is reported here rather than silently resulting in zero counts.
+void Tuner::UseHardwareCounters(const bool enabled, const uint64_t vector_event) {
+  if (!enabled) {
+    pimpl->perf_counters_.reset();
+    return;
+  }
+  if (!pimpl->device().IsCPU()) {
+    fprintf(stdout, "%s Hardware counters only count host threads, but the device is not a CPU\n",
+            TunerImpl::kMessageWarning.c_str());
+  }
+  auto counters = std::unique_ptr<PerfCounters>(new PerfCounters(vector_event));
+  if (!counters->Start()) {
+    throw std::runtime_error("Hardware counters are not available (requires Linux and permission "
+                             "to use perf_event, see /proc/sys/kernel/perf_event_paranoid)");
+  }
+  auto unused = HardwareCounters{0, 0, 0, 0, 0};
+  counters->Stop(unused, 1);
+  pimpl->perf_counters_ = std::move(counters);
+}
+
+// Enables or disables energy measurement through RAPL
+void Tuner::UseEnergyMeasurement(const bool enabled) {
+  if (enabled) { pimpl->energy_meter_.reset(new RaplMeter()); }
+  else { pimpl->energy_meter_.reset(); }
+}
+
+// Measures the energy with a user-provided function
+void Tuner::SetEnergyFunction(EnergyFunction function) {
+  pimpl->energy_meter_.reset(new FunctionMeter(function));
+}
+
+// Sets the objective of the searchers
+void Tuner::SetObjective(const Objective objective) {
+  pimpl->objective_weights_ = {{objective, 1.0}};
+}
+
+// Sets a weighted sum of objectives for the searchers
+void Tuner::SetObjectiveWeights(const std::vector<std::pair<Objective,double>> &weights) {
+  if (weights.empty()) { throw std::runtime_error("At least one objective weight is required"); }
+  pimpl->objective_weights_ = weights;
+}
+
+// Adds a constraint on an objective
+void Tuner::AddObjectiveConstraint(const Objective objective, const double maximum) {
+  pimpl->objective_constraints_.push_back({objective, maximum});
+}
+
+// Sets the objectives of the Pareto front
+void Tuner::SetParetoObjectives(const std::vector<Objective> &objectives) {
+  pimpl->pareto_objectives_ = objectives;
+}
+
 // Creates a new buffer of type Memory (containing both host and device data) based on a source
 // vector of data. Then, upload it to the device and store the argument in a list.
 template <typename T>
 void Tuner::AddArgumentInput(const size_t id, const std::vector<T> &source) {
   if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
-  auto device_buffer = Buffer<T>(pimpl->context(), BufferAccess::kNotOwned, source.size());
-  device_buffer.Write(pimpl->queue(), source.size(), source);
+  auto device_buffer = pimpl->UploadArgument(source);
   auto argument = KernelInfo::MemArgument{ pimpl->kernels_[id].argument_counter(), source.size(),
-                                         pimpl->GetType<T>(), device_buffer()};
+                                         pimpl->GetType<T>(), device_buffer};
   pimpl->kernels_[id].AddArgumentInput(argument);
 }
 
@@ -200,11 +344,12 @@ template void PUBLIC_API Tuner::AddArgumentInput<double2>(const size_t id, const
 // Same as above for reference kernel
 template <typename T>
 void Tuner::AddArgumentInputReference(const std::vector<T> &source) {
-    auto device_buffer = Buffer<T>(pimpl->context(), BufferAccess::kNotOwned, source.size());
-    device_buffer.Write(pimpl->queue(), source.size(), source);
+    auto device_buffer = pimpl->UploadArgument(source);
     auto argument = KernelInfo::MemArgument{ pimpl->reference_kernel_->argument_counter(), source.size(),
-        pimpl->GetType<T>(), device_buffer() };
+        pimpl->GetType<T>(), device_buffer };
     pimpl->reference_kernel_->AddArgumentInput(argument);
+    pimpl->AddReferenceArgumentKey("input", pimpl->GetType<T>(), source.data(),
+                                   source.size() * sizeof(T));
 }
 
 template void PUBLIC_API Tuner::AddArgumentInputReference<short>(const std::vector<short>&);
@@ -216,15 +361,248 @@ template void PUBLIC_API Tuner::AddArgumentInputReference<double>(const std::vec
 template void PUBLIC_API Tuner::AddArgumentInputReference<float2>(const std::vector<float2>&);
 template void PUBLIC_API Tuner::AddArgumentInputReference<double2>(const std::vector<double2>&);
 
+// Creates an input argument from (a byte range of) a file. The file is mapped only while uploading.
+template <typename T>
+void Tuner::AddArgumentInputFromFile(const size_t id, const std::string &filename,
+                                     const size_t offset, const size_t num_bytes) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  const MappedFile file(filename, offset, num_bytes);
+  auto device_buffer = pimpl->UploadFile<T>(file);
+  auto argument = KernelInfo::MemArgument{ pimpl->kernels_[id].argument_counter(),
+                                           file.size() / sizeof(T), pimpl->GetType<T>(),
+                                           device_buffer};
+  pimpl->kernels_[id].AddArgumentInput(argument);
+}
+
+// Compiles the function for various data-types
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<short>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<int>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<size_t>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<half>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<float>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<double>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<float2>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFile<double2>(const size_t, const std::string&,
+                                                              const size_t, const size_t);
+
+// Same as above for reference kernel. Hashing the file's contents for the reference cache would
+// require reading it completely, so the file is identified by its name, range, and modification time.
+template <typename T>
+void Tuner::AddArgumentInputFromFileReference(const std::string &filename, const size_t offset,
+                                              const size_t num_bytes) {
+  const MappedFile file(filename, offset, num_bytes);
+  auto device_buffer = pimpl->UploadFile<T>(file);
+  auto argument = KernelInfo::MemArgument{ pimpl->reference_kernel_->argument_counter(),
+                                           file.size() / sizeof(T), pimpl->GetType<T>(),
+                                           device_buffer};
+  pimpl->reference_kernel_->AddArgumentInput(argument);
+  auto identity = filename + " " + std::to_string(offset) + " " + std::to_string(file.size()) +
+                  " " + std::to_string(file.modification_time());
+  pimpl->AddReferenceArgumentKey("input-file", pimpl->GetType<T>(), identity.data(),
+                                 identity.size());
+}
+
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<short>(const std::string&,
+                                                                       const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<int>(const std::string&,
+                                                                       const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<size_t>(const std::string&,
+                                                                       const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<half>(const std::string&,
+                                                                       const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<float>(const std::string&,
+                                                                       const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<double>(const std::string&,
+                                                                       const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<float2>(const std::string&,
+                                                                       const size_t, const size_t);
+template void PUBLIC_API Tuner::AddArgumentInputFromFileReference<double2>(const std::string&,
+                                                                       const size_t, const size_t);
+
+// Creates an input argument filled on the device by the built-in generator
+template <typename T>
+void Tuner::AddArgumentInputGenerated(const size_t id, const size_t size,
+                                      const InputGenerator &generator) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  auto device_buffer = pimpl->GenerateArgument<T>(size, generator);
+  auto argument = KernelInfo::MemArgument{ pimpl->kernels_[id].argument_counter(), size,
+                                           pimpl->GetType<T>(), device_buffer};
+  pimpl->kernels_[id].AddArgumentInput(argument);
+}
+
+// Compiles the function for various data-types
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<short>(const size_t, const size_t,
+                                                               const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<int>(const size_t, const size_t,
+                                                               const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<size_t>(const size_t, const size_t,
+                                                               const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<half>(const size_t, const size_t,
+                                                               const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<float>(const size_t, const size_t,
+                                                               const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<double>(const size_t, const size_t,
+                                                               const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<float2>(const size_t, const size_t,
+                                                               const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGenerated<double2>(const size_t, const size_t,
+                                                               const InputGenerator&);
+
+// Same as above for reference kernel. For the reference cache, the generator describes the data.
+template <typename T>
+void Tuner::AddArgumentInputGeneratedReference(const size_t size,
+                                               const InputGenerator &generator) {
+  auto device_buffer = pimpl->GenerateArgument<T>(size, generator);
+  auto argument = KernelInfo::MemArgument{ pimpl->reference_kernel_->argument_counter(), size,
+                                           pimpl->GetType<T>(), device_buffer};
+  pimpl->reference_kernel_->AddArgumentInput(argument);
+  auto description = GeneratorDescription(generator) + " " + std::to_string(size);
+  pimpl->AddReferenceArgumentKey("input-generated", pimpl->GetType<T>(), description.data(),
+                                 description.size());
+}
+
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<short>(const size_t,
+                                                                        const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<int>(const size_t,
+                                                                        const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<size_t>(const size_t,
+                                                                        const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<half>(const size_t,
+                                                                        const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<float>(const size_t,
+                                                                        const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<double>(const size_t,
+                                                                        const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<float2>(const size_t,
+                                                                        const InputGenerator&);
+template void PUBLIC_API Tuner::AddArgumentInputGeneratedReference<double2>(const size_t,
+                                                                        const InputGenerator&);
+
+// Uploads a shared buffer. Its contents are described by a hash for the reference cache.
+template <typename T>
+void Tuner::AddSharedBuffer(const std::string &name, const std::vector<T> &source) {
+  auto description = std::to_string(source.size()) + " " +
+                     std::to_string(HashBytes(source.data(), source.size() * sizeof(T)));
+  auto shared_buffer = new KernelInfo::SharedBuffer{source.size(), pimpl->GetType<T>(),
+                                                    pimpl->UploadArgument(source), description};
+  pimpl->shared_buffers_[name] = std::shared_ptr<KernelInfo::SharedBuffer>(shared_buffer);
+}
+
+// Compiles the function for various data-types
+template void PUBLIC_API Tuner::AddSharedBuffer<short>(const std::string&, const std::vector<short>&);
+template void PUBLIC_API Tuner::AddSharedBuffer<int>(const std::string&, const std::vector<int>&);
+template void PUBLIC_API Tuner::AddSharedBuffer<size_t>(const std::string&, const std::vector<size_t>&);
+template void PUBLIC_API Tuner::AddSharedBuffer<half>(const std::string&, const std::vector<half>&);
+template void PUBLIC_API Tuner::AddSharedBuffer<float>(const std::string&, const std::vector<float>&);
+template void PUBLIC_API Tuner::AddSharedBuffer<double>(const std::string&, const std::vector<double>&);
+template void PUBLIC_API Tuner::AddSharedBuffer<float2>(const std::string&, const std::vector<float2>&);
+template void PUBLIC_API Tuner::AddSharedBuffer<double2>(const std::string&, const std::vector<double2>&);
+
+// Removes the tuner's reference to a shared buffer: kernels using it keep it alive
+void Tuner::ReleaseSharedBuffer(const std::string &name) {
+  if (pimpl->shared_buffers_.erase(name) == 0) {
+    throw std::runtime_error("Unknown shared buffer: " + name);
+  }
+}
+
+// Binds a shared buffer as an argument
+void Tuner::AddArgumentInputShared(const size_t id, const std::string &name) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  pimpl->kernels_[id].AddArgumentInput(pimpl->GetSharedBuffer(name));
+}
+void Tuner::AddArgumentOutputShared(const size_t id, const std::string &name) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  pimpl->kernels_[id].AddArgumentOutput(pimpl->GetSharedBuffer(name));
+}
+
+// Same as above for reference kernel
+void Tuner::AddArgumentInputSharedReference(const std::string &name) {
+  auto shared_buffer = pimpl->GetSharedBuffer(name);
+  pimpl->reference_kernel_->AddArgumentInput(shared_buffer);
+  pimpl->AddReferenceArgumentKey("input-shared", shared_buffer->type,
+                                 shared_buffer->description.data(),
+                                 shared_buffer->description.size());
+}
+void Tuner::AddArgumentOutputSharedReference(const std::string &name) {
+  auto shared_buffer = pimpl->GetSharedBuffer(name);
+  pimpl->reference_kernel_->AddArgumentOutput(shared_buffer);
+  pimpl->AddReferenceArgumentKey("output-shared", shared_buffer->type,
+                                 shared_buffer->description.data(),
+                                 shared_buffer->description.size());
+}
+
+// Keeps the data in host memory: the kernel is run in streaming mode. The data is copied, since it
+// is read while the kernel runs.
+template <typename T>
+void Tuner::AddArgumentInputStreamed(const size_t id, const std::vector<T> &source) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  auto bytes = reinterpret_cast<const unsigned char*>(source.data());
+  auto data = std::vector<unsigned char>(bytes, bytes + source.size() * sizeof(T));
+  auto argument = KernelInfo::StreamedArgument{ pimpl->kernels_[id].argument_counter(),
+                                                source.size(), pimpl->GetType<T>(),
+                                                std::move(data)};
+  pimpl->kernels_[id].AddArgumentInputStreamed(std::move(argument));
+}
+template <typename T>
+void Tuner::AddArgumentOutputStreamed(const size_t id, const std::vector<T> &source) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  auto bytes = reinterpret_cast<const unsigned char*>(source.data());
+  auto data = std::vector<unsigned char>(bytes, bytes + source.size() * sizeof(T));
+  auto argument = KernelInfo::StreamedArgument{ pimpl->kernels_[id].argument_counter(),
+                                                source.size(), pimpl->GetType<T>(),
+                                                std::move(data)};
+  pimpl->kernels_[id].AddArgumentOutputStreamed(std::move(argument));
+}
+
+// Compiles the functions for various data-types
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<short>(const size_t,
+                                                                const std::vector<short>&);
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<int>(const size_t,
+                                                              const std::vector<int>&);
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<size_t>(const size_t,
+                                                                 const std::vector<size_t>&);
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<half>(const size_t,
+                                                               const std::vector<half>&);
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<float>(const size_t,
+                                                                const std::vector<float>&);
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<double>(const size_t,
+                                                                 const std::vector<double>&);
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<float2>(const size_t,
+                                                                 const std::vector<float2>&);
+template void PUBLIC_API Tuner::AddArgumentInputStreamed<double2>(const size_t,
+                                                                  const std::vector<double2>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<short>(const size_t,
+                                                                 const std::vector<short>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<int>(const size_t,
+                                                               const std::vector<int>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<size_t>(const size_t,
+                                                                  const std::vector<size_t>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<half>(const size_t,
+                                                                const std::vector<half>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<float>(const size_t,
+                                                                 const std::vector<float>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<double>(const size_t,
+                                                                  const std::vector<double>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<float2>(const size_t,
+                                                                  const std::vector<float2>&);
+template void PUBLIC_API Tuner::AddArgumentOutputStreamed<double2>(const size_t,
+                                                                   const std::vector<double2>&);
+
 // Similar to the above function, but now marked as output buffer. Output buffers are special in the
 // sense that they will be checked in the verification process.
 template <typename T>
 void Tuner::AddArgumentOutput(const size_t id, const std::vector<T> &source) {
   if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
-  auto device_buffer = Buffer<T>(pimpl->context(), BufferAccess::kNotOwned, source.size());
-  device_buffer.Write(pimpl->queue(), source.size(), source);
+  auto device_buffer = pimpl->UploadArgument(source);
   auto argument = KernelInfo::MemArgument{ pimpl->kernels_[id].argument_counter(), source.size(),
-                                         pimpl->GetType<T>(), device_buffer()};
+                                         pimpl->GetType<T>(), device_buffer};
   pimpl->kernels_[id].AddArgumentOutput(argument);
 }
 
@@ -241,11 +619,12 @@ template void PUBLIC_API Tuner::AddArgumentOutput<double2>(const size_t id, cons
 // Same as above for reference kernel
 template <typename T>
 void Tuner::AddArgumentOutputReference(const std::vector<T> &source) {
-    auto device_buffer = Buffer<T>(pimpl->context(), BufferAccess::kNotOwned, source.size());
-    device_buffer.Write(pimpl->queue(), source.size(), source);
+    auto device_buffer = pimpl->UploadArgument(source);
     auto argument = KernelInfo::MemArgument{ pimpl->reference_kernel_->argument_counter(), source.size(),
-        pimpl->GetType<T>(), device_buffer() };
+        pimpl->GetType<T>(), device_buffer };
     pimpl->reference_kernel_->AddArgumentOutput(argument);
+    pimpl->AddReferenceArgumentKey("output", pimpl->GetType<T>(), source.data(),
+                                   source.size() * sizeof(T));
 }
 
 template void PUBLIC_API Tuner::AddArgumentOutputReference<short>(const std::vector<short>&);
@@ -296,27 +675,35 @@ template <> void PUBLIC_API Tuner::AddArgumentScalar<double2>(const size_t id, c
 // Same as above for reference kernel
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<short>(const short argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<short>(), &argument, sizeof(argument));
 }
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<int>(const int argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<int>(), &argument, sizeof(argument));
 }
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<size_t>(const size_t argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<size_t>(), &argument, sizeof(argument));
 }
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<half>(const half argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<half>(), &argument, sizeof(argument));
 }
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<float>(const float argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<float>(), &argument, sizeof(argument));
 }
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<double>(const double argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<double>(), &argument, sizeof(argument));
 }
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<float2>(const float2 argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<float2>(), &argument, sizeof(argument));
 }
 template <> void PUBLIC_API Tuner::AddArgumentScalarReference<double2>(const double2 argument) {
     pimpl->reference_kernel_->AddArgumentScalar(argument);
+    pimpl->AddReferenceArgumentKey("scalar", pimpl->GetType<double2>(), &argument, sizeof(argument));
 }
 
 // =================================================================================================
@@ -347,12 +734,75 @@ void Tuner::UsePSO(const size_t id, const double fraction, const size_t swarm_si
   pimpl->kernels_[id].UsePSO(fraction, swarm_size, influence_global, influence_local, influence_random);
 }
 
+// Keeps the results of which the parameters are exactly those of the kernel, i.e. not those of
+// another version of the kernel. Their values may be outside of the current search space.
+void Tuner::UseWarmStart(const size_t id, const std::string &filename, const size_t num_points) {
+  if (id >= pimpl->kernels_.size()) { throw std::runtime_error("Invalid kernel ID"); }
+  auto parameters = pimpl->kernels_[id].parameters();
+  auto &points = pimpl->warm_starts_[id];
+  auto num_found = size_t{0};
+  for (auto &result: ReadWarmStart(filename, pimpl->kernels_[id].name())) {
+    if (num_found == num_points) { break; }
+    if (result.size() != parameters.size()) { continue; }
+    auto configuration = KernelInfo::Configuration();
+    for (auto &parameter: parameters) {
+      for (auto &setting: result) {
+        if (setting.first == parameter.name) {
+          configuration.push_back(KernelInfo::Setting{parameter.name, setting.second});
+          break;
+        }
+      }
+    }
+    if (configuration.size() != parameters.size()) { continue; }
+    points.push_back(configuration);
+    ++num_found;
+  }
+  if (num_found == 0) {
+    fprintf(stdout, "%s No results of kernel '%s' in '%s' to start from\n",
+            TunerImpl::kMessageWarning.c_str(), pimpl->kernels_[id].name().c_str(),
+            filename.c_str());
+  }
+}
+
 // Choose verification method.
 void Tuner::ChooseVerificationMethod(const VerificationMethod method,
                                      const double tolerance_treshold) {
   if (tolerance_treshold < 0.0) { throw std::runtime_error("Invalid tolerance treshold"); }
   pimpl->verification_method_ = method;
   pimpl->tolerance_treshold_ = tolerance_treshold;
+  pimpl->verify_top_k_ = 0;
+  pimpl->audit_fraction_ = 0.0;
+}
+
+// Choose verification method with deferred verification of the fastest configurations only
+void Tuner::ChooseVerificationMethod(const VerificationMethod method,
+                                     const double tolerance_treshold,
+                                     const size_t verify_top_k, const double audit_fraction) {
+  if (audit_fraction < 0.0 || audit_fraction > 1.0) {
+    throw std::runtime_error("Invalid audit fraction");
+  }
+  ChooseVerificationMethod(method, tolerance_treshold);
+  pimpl->verify_top_k_ = verify_top_k;
+  pimpl->audit_fraction_ = audit_fraction;
+}
+
+// Sets the detection probability and seed for sampled verification
+void Tuner::UseSampledVerification(const double detection_probability,
+                                   const double error_fraction, const unsigned int seed) {
+  if (detection_probability <= 0.0 || detection_probability > 1.0) {
+    throw std::runtime_error("Invalid detection probability");
+  }
+  if (error_fraction <= 0.0 || error_fraction >= 1.0) {
+    throw std::runtime_error("Invalid error fraction");
+  }
+  pimpl->detection_probability_ = detection_probability;
+  pimpl->error_fraction_ = error_fraction;
+  pimpl->sample_generator_.seed(seed);
+}
+
+// Sets the directory of the on-disk reference cache
+void Tuner::UseReferenceCache(const std::string &directory) {
+  pimpl->reference_cache_.SetDirectory(directory);
 }
 
 // Output the search process to a file. This is disabled per default.
@@ -363,6 +813,53 @@ void Tuner::OutputSearchLog(const std::string &filename) {
 
 // =================================================================================================
 
+// Sets the fixed time limits
+void Tuner::SetTimeouts(const float compile_timeout_ms, const float run_timeout_ms) {
+  if (compile_timeout_ms < 0.0f || run_timeout_ms < 0.0f) {
+    throw std::runtime_error("Timeouts should not be negative (0 disables them)");
+  }
+  pimpl->compile_timeout_ms_ = compile_timeout_ms;
+  pimpl->run_timeout_ms_ = run_timeout_ms;
+}
+
+// Sets the run-time limit relative to the best time so far
+void Tuner::SetRelativeTimeout(const float multiple_of_best) {
+  if (multiple_of_best != 0.0f && multiple_of_best < 1.0f) {
+    throw std::runtime_error("Relative timeout should be at least 1 (or 0 to disable it)");
+  }
+  pimpl->relative_timeout_ = multiple_of_best;
+}
+
+// =================================================================================================
+
+// Enables distributed tuning: configurations are evaluated by workers connecting to the address
+void Tuner::UseDistributedTuning(const std::string &address, const size_t num_local_workers) {
+  if (address.empty()) { throw std::runtime_error("Empty distributed tuning address"); }
+  pimpl->distributed_address_ = address;
+  pimpl->num_local_workers_ = num_local_workers;
+  pimpl->max_worker_losses_ = Coordinator::kMaxLosses;
+  pimpl->worker_timeout_ms_ = 0.0f;
+}
+
+// Enables isolated execution: distributed tuning with a single local worker over a private socket.
+// Any lost configuration is the likely culprit, so it is marked as failed directly.
+void Tuner::UseIsolatedExecution(const float timeout_ms) {
+  pimpl->distributed_address_ = PrivateAddress();
+  if (pimpl->distributed_address_.empty()) {
+    throw std::runtime_error("Isolated execution is not supported on this platform");
+  }
+  pimpl->num_local_workers_ = 1;
+  pimpl->max_worker_losses_ = 1;
+  pimpl->worker_timeout_ms_ = timeout_ms;
+}
+
+// Returns whether this process was started as a worker
+bool Tuner::IsDistributedWorker() const {
+  return pimpl->IsDistributedWorker();
+}
+
+// =================================================================================================
+
 // Starts the tuning process. See the TunerImpl's implemenation for details
 std::vector<PublicTunerResult> Tuner::TuneAllKernels() {
   return pimpl->TuneAllKernels();
@@ -376,6 +873,88 @@ std::vector<PublicTunerResult> Tuner::TuneSingleKernel(const size_t id) {
   return pimpl->TuneSingleKernel(id, true, true);
 }
 
+// Tunes the sizes from the outside in: the smallest and largest sizes first, and then the middle
+// size of each range of which the ends have different best configurations. Sizes in a range of
+// which both ends have the same best configuration only run that configuration, to confirm that it
+// is valid for them. Each size has its own tuner, which is destroyed once the size is done.
+std::vector<SweepInterval> Tuner::TuneSweep(const std::vector<size_t> &sizes, SweepFunction setup) {
+  auto sorted = sizes;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  if (sorted.empty()) { throw std::runtime_error("No problem sizes to sweep"); }
+  auto configurations = std::vector<ParameterRange>(sorted.size());
+  auto num_tuned = size_t{0};
+  auto tune = [&](const size_t i) {
+    pimpl->PrintHeader("Tuning problem size " + std::to_string(sorted[i]));
+    Tuner tuner(pimpl->platform_id_, pimpl->device_id_);
+    auto results = tuner.TuneSingleKernel(setup(tuner, sorted[i]));
+    auto best_result = static_cast<const PublicTunerResult*>(nullptr);
+    for (auto &result: results) {
+      if (!result.status || result.time == std::numeric_limits<float>::max()) { continue; }
+      if (best_result == nullptr || result.time < best_result->time) { best_result = &result; }
+    }
+    if (best_result == nullptr) {
+      throw std::runtime_error("No valid configuration for size " + std::to_string(sorted[i]));
+    }
+    configurations[i] = best_result->parameter_values;
+    pimpl->sweep_kernel_ = best_result->kernel_name;
+    num_tuned++;
+  };
+  auto confirm = [&](const size_t i, const ParameterRange &configuration) {
+    Tuner tuner(pimpl->platform_id_, pimpl->device_id_);
+    auto id = setup(tuner, sorted[i]);
+    tuner.RunReferenceKernel(); // Verification of the output, if 'setup' has set a reference
+    auto result = tuner.RunSingleKernel(id, configuration);
+    if (!result.status || result.time == std::numeric_limits<float>::max()) { tune(i); }
+    else { configurations[i] = configuration; }
+  };
+
+  tune(0);
+  if (sorted.size() > 1) { tune(sorted.size() - 1); }
+  auto ranges = std::vector<std::pair<size_t,size_t>>{{0, sorted.size() - 1}};
+  while (!ranges.empty()) {
+    auto range = ranges.back();
+    ranges.pop_back();
+    if (range.second - range.first < 2) { continue; }
+    if (configurations[range.first] == configurations[range.second]) {
+      for (auto i = range.first + 1; i < range.second; ++i) {
+        confirm(i, configurations[range.first]);
+      }
+    }
+    else {
+      auto middle = (range.first + range.second) / 2;
+      tune(middle);
+      ranges.push_back({middle, range.second});
+      ranges.push_back({range.first, middle});
+    }
+  }
+
+  // Merges neighbouring sizes with the same configuration into intervals, placing the boundaries
+  // halfway between the sizes
+  auto intervals = std::vector<SweepInterval>();
+  for (auto i = size_t{0}; i < sorted.size(); ++i) {
+    if (!intervals.empty() && intervals.back().configuration == configurations[i]) { continue; }
+    auto min_size = (i == 0) ? 0 : sorted[i - 1] + (sorted[i] - sorted[i - 1]) / 2 + 1;
+    if (!intervals.empty()) { intervals.back().max_size = min_size - 1; }
+    intervals.push_back(SweepInterval{min_size, std::numeric_limits<size_t>::max(),
+                                      configurations[i]});
+  }
+  pimpl->sweep_intervals_ = intervals;
+
+  // Prints the intervals
+  pimpl->PrintHeader("Sweep of " + pimpl->sweep_kernel_ + ": tuned " + std::to_string(num_tuned) +
+                     " out of " + std::to_string(sorted.size()) + " sizes");
+  for (auto &interval: intervals) {
+    fprintf(stdout, "%s Sizes %zu to %zu:", TunerImpl::kMessageResult.c_str(), interval.min_size,
+            interval.max_size);
+    for (auto &parameter: interval.configuration) {
+      fprintf(stdout, " %s %zu;", parameter.first.c_str(), parameter.second);
+    }
+    fprintf(stdout, "\n");
+  }
+  return intervals;
+}
+
 // =================================================================================================
 
 // Returns number of unique configurations for given kernel based on specified parameters and search method.
@@ -434,6 +1013,12 @@ void Tuner::ModelPrediction(const Model model_type, const float validation_fract
 // timing-results. Printing is to stdout.
 double Tuner::PrintToScreen() const {
 
+  // Aborts if there are no results at all (e.g. in a distributed worker process)
+  if (pimpl->tuning_results_.empty()) {
+    pimpl->PrintHeader("No tuner results found");
+    return 0.0;
+  }
+
   // Finds the best result
   auto best_result = pimpl->tuning_results_[0];
   auto best_time = std::numeric_limits<double>::max();
@@ -460,12 +1045,23 @@ double Tuner::PrintToScreen() const {
   pimpl->PrintHeader("Printing best result to stdout");
   pimpl->PrintResult(stdout, best_result, pimpl->kMessageBest);
 
+  // Prints the Pareto front of each kernel
+  if (!pimpl->pareto_objectives_.empty()) {
+    pimpl->PrintHeader("Printing the Pareto front to stdout");
+    auto optimal = pimpl->ParetoOptimal();
+    for (auto r = size_t{0}; r < optimal.size(); ++r) {
+      if (!optimal[r]) { continue; }
+      pimpl->PrintResult(stdout, pimpl->tuning_results_[r], pimpl->kMessageResult);
+    }
+  }
+
   // Return the best time
   return best_time;
 }
 
 // Prints the best result in a neatly formatted C++ database format to screen
 void Tuner::PrintFormatted() const {
+  if (pimpl->tuning_results_.empty()) { return; }
 
   // Finds the best result
   auto best_result = pimpl->tuning_results_[0];
@@ -508,13 +1104,27 @@ void Tuner::PrintJSON(const std::string &filename,
   fprintf(file, "  \"device_type\": \"%s\",\n", device_type.c_str());
   fprintf(file, "  \"device_core_clock\": \"%zu\",\n", pimpl->device().CoreClock());
   fprintf(file, "  \"device_compute_units\": \"%zu\",\n", pimpl->device().ComputeUnits());
+  if (!pimpl->drift_sentinels_.empty()) {
+    fprintf(file, "  \"drift_events\": [");
+    for (auto e = size_t{0}; e < pimpl->drift_events_.size(); ++e) {
+      auto &event = pimpl->drift_events_[e];
+      fprintf(file, "%s\n    {\"kernel\": \"%s\", \"configuration\": %zu, \"drift\": %.3lf, "
+              "\"remeasured\": %zu}", (e == 0) ? "" : ",", event.kernel_name.c_str(),
+              event.configuration, event.drift, event.num_remeasured);
+    }
+    fprintf(file, "\n  ],\n");
+  }
   fprintf(file, "  \"results\": [\n");
 
   // Filters failed configurations
   auto results = std::vector<TunerImpl::TunerResult>();
-  for (const auto &tuning_result: pimpl->tuning_results_) {
+  auto pareto_optimal = std::vector<bool>();
+  auto optimal = pimpl->ParetoOptimal();
+  for (auto i = size_t{0}; i < pimpl->tuning_results_.size(); ++i) {
+    const auto &tuning_result = pimpl->tuning_results_[i];
     if (tuning_result.status && tuning_result.time != std::numeric_limits<double>::max()) {
       results.push_back(tuning_result);
+      pareto_optimal.push_back(optimal[i]);
     }
   }
 
@@ -525,6 +1135,36 @@ void Tuner::PrintJSON(const std::string &filename,
     fprintf(file, "    {\n");
     fprintf(file, "      \"kernel\": \"%s\",\n", result.kernel_name.c_str());
     fprintf(file, "      \"time\": %.3lf,\n", result.time);
+    fprintf(file, "      \"timings\": {\"kernel\": %.3lf, \"submitted\": %.3lf, \"queued\": %.3lf, "
+            "\"wall_clock\": %.3lf},\n", result.timings.kernel, result.timings.submitted,
+            result.timings.queued, result.timings.wall_clock);
+    if (pimpl->perf_counters_) {
+      auto &counters = result.counters;
+      fprintf(file, "      \"counters\": {\"cycles\": %llu, \"instructions\": %llu, "
+              "\"llc_misses\": %llu, \"branch_misses\": %llu, \"vector_instructions\": %llu},\n",
+              static_cast<unsigned long long>(counters.cycles),
+              static_cast<unsigned long long>(counters.instructions),
+              static_cast<unsigned long long>(counters.llc_misses),
+              static_cast<unsigned long long>(counters.branch_misses),
+              static_cast<unsigned long long>(counters.vector_instructions));
+    }
+    if (pimpl->energy_meter_) {
+      fprintf(file, "      \"energy\": %.6lf,\n", result.energy);
+      fprintf(file, "      \"power\": %.3lf,\n", result.power);
+    }
+    fprintf(file, "      \"run_times\": [");
+    for (auto t = size_t{0}; t < result.run_times.size(); ++t) {
+      fprintf(file, "%s%.3lf", (t == 0) ? "" : ", ", result.run_times[t]);
+    }
+    fprintf(file, "],\n");
+    if (!pimpl->drift_sentinels_.empty()) {
+      fprintf(file, "      \"drift\": %.3lf,\n", result.drift);
+    }
+    fprintf(file, "      \"compile_time\": %.3lf,\n", result.compile_time);
+    fprintf(file, "      \"local_memory\": %zu,\n", result.local_memory);
+    if (!pimpl->pareto_objectives_.empty()) {
+      fprintf(file, "      \"pareto_optimal\": %s,\n", pareto_optimal[r] ? "true" : "false");
+    }
 
     // Loops over all the parameters for this result
     fprintf(file, "      \"parameters\": {");
@@ -546,12 +1186,87 @@ void Tuner::PrintJSON(const std::string &filename,
   fclose(file);
 }
 
+// Merges the best result of each kernel into the dispatch header
+void Tuner::PrintDispatchHeader(const std::string &filename, const std::string &size_class) const {
+  pimpl->PrintHeader("Printing best results to dispatch header " + filename);
+  auto entries = ReadDispatchHeader(filename);
+  for (auto &kernel: pimpl->kernels_) {
+    auto best_result = static_cast<const TunerImpl::TunerResult*>(nullptr);
+    for (auto &tuning_result: pimpl->tuning_results_) {
+      if (tuning_result.kernel_name != kernel.name() || !tuning_result.status) { continue; }
+      if (best_result == nullptr || tuning_result.time < best_result->time) {
+        best_result = &tuning_result;
+      }
+    }
+    if (best_result == nullptr) { continue; }
+    auto entry = DispatchEntry{kernel.name(), pimpl->device().Name(), size_class,
+                               best_result->time, {}};
+    for (auto &setting: best_result->configuration) {
+      entry.parameters.push_back({setting.name, setting.value});
+    }
+    AddDispatchEntry(entries, entry);
+  }
+  if (entries.empty()) { throw std::runtime_error("No results for the dispatch header"); }
+  WriteDispatchHeader(filename, entries);
+}
+
+// Writes the intervals of the last sweep
+void Tuner::PrintSweepHeader(const std::string &filename) const {
+  if (pimpl->sweep_intervals_.empty()) { throw std::runtime_error("No sweep for the header"); }
+  pimpl->PrintHeader("Printing sweep to header " + filename);
+  WriteSweepHeader(filename, pimpl->sweep_kernel_, pimpl->device().Name(), pimpl->sweep_intervals_);
+}
+
+// Compiles the best result of each kernel and merges its binary into the bundle
+void Tuner::SaveBinaryBundle(const std::string &filename) {
+  pimpl->PrintHeader("Saving best results to binary bundle " + filename);
+  auto entries = std::vector<BundleEntry>();
+  std::ifstream existing(filename);
+  if (existing.good()) {
+    existing.close();
+    entries = BinaryBundle(filename).Entries();
+  }
+  auto device = pimpl->device();
+  for (auto id = size_t{0}; id < pimpl->kernels_.size(); ++id) {
+    auto &kernel = pimpl->kernels_[id];
+    auto best_result = static_cast<const TunerImpl::TunerResult*>(nullptr);
+    for (auto &tuning_result: pimpl->tuning_results_) {
+      if (tuning_result.kernel_name != kernel.name() || !tuning_result.status) { continue; }
+      if (best_result == nullptr || tuning_result.time < best_result->time) {
+        best_result = &tuning_result;
+      }
+    }
+    if (best_result == nullptr) { continue; }
+    auto source = pimpl->GetConfiguredKernelSource(id, best_result->configuration);
+    auto program = Program(pimpl->context(), source);
+    auto options = std::vector<std::string>{};
+    if (pimpl->BuildProgram(program, options) != BuildStatus::kSuccess) {
+      throw std::runtime_error("Could not compile " + kernel.name() + " for the binary bundle");
+    }
+    auto entry = BundleEntry{kernel.name(), device.Name(), device.DriverVersion(), source,
+                             program.GetIR()};
+    auto replaced = false;
+    for (auto &other: entries) {
+      if (other.kernel == entry.kernel && other.device == entry.device &&
+          other.driver == entry.driver) {
+        other = entry;
+        replaced = true;
+      }
+    }
+    if (!replaced) { entries.push_back(entry); }
+  }
+  if (entries.empty()) { throw std::runtime_error("No results for the binary bundle"); }
+  BinaryBundle::Save(filename, entries);
+}
+
 // Same as PrintToScreen, but now outputs into a file and does not mark the best-case
 void Tuner::PrintToFile(const std::string &filename) const {
   pimpl->PrintHeader("Printing results to file: "+filename);
   auto file = fopen(filename.c_str(), "w");
   std::vector<std::string> processed_kernels;
-  for (auto &tuning_result: pimpl->tuning_results_) {
+  auto pareto_optimal = pimpl->ParetoOptimal();
+  for (auto r = size_t{0}; r < pimpl->tuning_results_.size(); ++r) {
+    auto &tuning_result = pimpl->tuning_results_[r];
     if (tuning_result.status) {
 
       // Checks whether this is a kernel which hasn't been encountered yet
@@ -564,6 +1279,11 @@ void Tuner::PrintToFile(const std::string &filename) const {
       // Prints the header in case of a new kernel name
       if (new_kernel) {
         fprintf(file, "name;time;threads;");
+        if (pimpl->perf_counters_) {
+          fprintf(file, "cycles;instructions;llc_misses;branch_misses;vector_instructions;");
+        }
+        if (pimpl->energy_meter_) { fprintf(file, "energy;power;"); }
+        if (!pimpl->pareto_objectives_.empty()) { fprintf(file, "pareto;"); }
         for (auto &setting: tuning_result.configuration) {
           fprintf(file, "%s;", setting.name.c_str());
         }
@@ -574,6 +1294,18 @@ void Tuner::PrintToFile(const std::string &filename) const {
       fprintf(file, "%s;", tuning_result.kernel_name.c_str());
       fprintf(file, "%.2lf;", tuning_result.time);
       fprintf(file, "%zu;", tuning_result.threads);
+      if (pimpl->perf_counters_) {
+        auto &counters = tuning_result.counters;
+        fprintf(file, "%llu;%llu;%llu;%llu;%llu;", static_cast<unsigned long long>(counters.cycles),
+                static_cast<unsigned long long>(counters.instructions),
+                static_cast<unsigned long long>(counters.llc_misses),
+                static_cast<unsigned long long>(counters.branch_misses),
+                static_cast<unsigned long long>(counters.vector_instructions));
+      }
+      if (pimpl->energy_meter_) {
+        fprintf(file, "%.6lf;%.3lf;", tuning_result.energy, tuning_result.power);
+      }
+      if (!pimpl->pareto_objectives_.empty()) { fprintf(file, "%d;", pareto_optimal[r] ? 1 : 0); }
       for (auto &setting: tuning_result.configuration) {
         fprintf(file, "%zu;", setting.value);
       }
@@ -583,6 +1315,17 @@ void Tuner::PrintToFile(const std::string &filename) const {
   fclose(file);
 }
 
+// Saves the trace, which is only recorded when compiled with the TRACE option
+void Tuner::SaveTrace(const std::string &filename) const {
+  #ifdef CLTUNE_TRACE
+    pimpl->PrintHeader("Saving trace to file: "+filename);
+    Trace::Save(filename);
+  #else
+    fprintf(stdout, "%s Not saving '%s': compile with the TRACE option to record a trace\n",
+            TunerImpl::kMessageWarning.c_str(), filename.c_str());
+  #endif
+}
+
 // Set the flag to suppress output to true. Note that this cannot be undone.
 void Tuner::SuppressOutput() {
   pimpl->suppress_output_ = true;
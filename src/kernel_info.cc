@@ -27,8 +27,10 @@
 
 // The corresponding header file
 #include "internal/kernel_info.h"
+#include "internal/trace.h"
 
 #include <cassert>
+#include <utility> // std::move
 
 namespace cltune {
 // =================================================================================================
@@ -47,6 +49,9 @@ KernelInfo::KernelInfo(const std::string name, const std::string source, const D
   global_(), local_(),
   iterations_(IterationsModifier{ std::vector<size_t>{1}, std::string{""} }),
   num_current_iterations_(1),
+  streaming_(StreamingModifier{ std::string{""}, std::string{""} }),
+  num_current_chunks_(1),
+  num_current_in_flight_(1),
   search_method_(SearchMethod::FullSearch),
   search_args_(0),
   argument_counter_(0),
@@ -54,18 +59,22 @@ KernelInfo::KernelInfo(const std::string name, const std::string source, const D
 }
 
 KernelInfo::~KernelInfo() {
-  // Frees the device buffers
-  auto free_buffers = [](MemArgument &mem_info) {
-  #ifdef USE_OPENCL
-    CheckError(clReleaseMemObject(mem_info.buffer));
-  #else
-    CheckError(cuMemFree(mem_info.buffer));
-  #endif
+  // Frees the device buffers, except for the shared buffers
+  auto free_buffers = [this](MemArgument &mem_info) {
+    for (auto &shared_buffer : shared_buffers_) {
+      if (shared_buffer->buffer == mem_info.buffer) { return; }
+    }
+    FreeBuffer(mem_info.buffer);
   };
   for (auto &mem_argument : arguments_input_) { free_buffers(mem_argument); }
   for (auto &mem_argument : arguments_output_) { free_buffers(mem_argument); }
 }
 
+// Frees the device buffer of a shared buffer
+KernelInfo::SharedBuffer::~SharedBuffer() {
+  FreeBuffer(buffer);
+}
+
 // =================================================================================================
 
 void KernelInfo::PrependSource(const std::string &extra_source) {
@@ -177,11 +186,23 @@ void KernelInfo::SetNumCurrentIterations(const Configuration &config) {
   }
 }
 
+// Computes the number of chunks and the number of chunks in flight based on the current
+// configuration. Without parameters, a streamed kernel is run as a single chunk.
+void KernelInfo::SetNumCurrentChunks(const Configuration &config) {
+  num_current_chunks_ = 1;
+  num_current_in_flight_ = 1;
+  for (auto &setting : config) {
+    if (setting.name == streaming_.chunks_parameter) { num_current_chunks_ = setting.value; }
+    if (setting.name == streaming_.in_flight_parameter) { num_current_in_flight_ = setting.value; }
+  }
+}
+
 // =================================================================================================
 
 // Initializes an empty configuration (vector of name/value pairs) and kicks-off the recursive
 // function to find all configurations. It also applies the user-defined constraints within.
 void KernelInfo::SetConfigurations() {
+  TRACE_SPAN("tuner", "SetConfigurations");
   auto config = Configuration(parameters_.size());
   PopulateConfigurations(0, config);
 }
@@ -307,6 +328,28 @@ void KernelInfo::AddArgumentOutput(const MemArgument &argument) {
   argument_counter_++;
 }
 
+// Binds a shared buffer as argument, keeping a reference to it
+void KernelInfo::AddArgumentInput(const std::shared_ptr<SharedBuffer> &buffer) {
+  shared_buffers_.push_back(buffer);
+  AddArgumentInput(MemArgument{argument_counter_, buffer->size, buffer->type, buffer->buffer});
+}
+
+void KernelInfo::AddArgumentOutput(const std::shared_ptr<SharedBuffer> &buffer) {
+  shared_buffers_.push_back(buffer);
+  AddArgumentOutput(MemArgument{argument_counter_, buffer->size, buffer->type, buffer->buffer});
+}
+
+// Arguments in host memory (moved in, since these can be large)
+void KernelInfo::AddArgumentInputStreamed(StreamedArgument argument) {
+  arguments_input_streamed_.push_back(std::move(argument));
+  argument_counter_++;
+}
+
+void KernelInfo::AddArgumentOutputStreamed(StreamedArgument argument) {
+  arguments_output_streamed_.push_back(std::move(argument));
+  argument_counter_++;
+}
+
 void KernelInfo::AddArgumentScalar(const short argument) {
   arguments_int_.push_back({ argument_counter_++, argument });
 }
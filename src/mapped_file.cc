@@ -0,0 +1,151 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the MappedFile class (see the header for information about the class).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/mapped_file.h"
+
+#include <stdexcept> // std::runtime_error
+#include <algorithm> // std::min
+
+#ifdef _WIN32
+  #include <fstream> // std::ifstream
+  #include <sys/stat.h> // _stat
+#else
+  #include <unistd.h> // close, sysconf
+  #include <fcntl.h> // open
+  #include <sys/mman.h> // mmap, munmap, madvise
+  #include <sys/stat.h> // fstat
+#endif
+
+namespace cltune {
+// =================================================================================================
+
+// Maps the range of the file. The mapping itself has to start at a page boundary.
+MappedFile::MappedFile(const std::string &filename, const size_t offset, const size_t size):
+    mapping_(nullptr),
+    mapping_size_(0),
+    data_(nullptr),
+    size_(size),
+    modification_time_(0),
+    buffer_() {
+  #ifndef _WIN32
+    auto file = open(filename.c_str(), O_RDONLY);
+    if (file < 0) { throw std::runtime_error("Could not open file: " + filename); }
+    struct stat file_status;
+    if (fstat(file, &file_status) != 0) {
+      close(file);
+      throw std::runtime_error("Could not determine the size of file: " + filename);
+    }
+    auto file_size = static_cast<size_t>(file_status.st_size);
+    modification_time_ = static_cast<long long>(file_status.st_mtime);
+    if (size_ == 0 && offset < file_size) { size_ = file_size - offset; }
+    if (size_ == 0 || offset + size_ > file_size) {
+      close(file);
+      throw std::runtime_error("Invalid byte range of file: " + filename);
+    }
+    auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto mapping_offset = (offset / page_size) * page_size;
+    mapping_size_ = size_ + (offset - mapping_offset);
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, file,
+                    static_cast<off_t>(mapping_offset));
+    close(file);
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = nullptr;
+      throw std::runtime_error("Could not map file: " + filename);
+    }
+    data_ = static_cast<const unsigned char*>(mapping_) + (offset - mapping_offset);
+  #else
+    struct _stat file_status;
+    if (_stat(filename.c_str(), &file_status) != 0) {
+      throw std::runtime_error("Could not open file: " + filename);
+    }
+    auto file_size = static_cast<size_t>(file_status.st_size);
+    modification_time_ = static_cast<long long>(file_status.st_mtime);
+    if (size_ == 0 && offset < file_size) { size_ = file_size - offset; }
+    if (size_ == 0 || offset + size_ > file_size) {
+      throw std::runtime_error("Invalid byte range of file: " + filename);
+    }
+    auto file = std::ifstream(filename, std::ios::binary);
+    buffer_.resize(size_);
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(size_));
+    if (!file) { throw std::runtime_error("Could not read file: " + filename); }
+    data_ = buffer_.data();
+  #endif
+}
+
+// Unmaps the file
+MappedFile::~MappedFile() {
+  #ifndef _WIN32
+    if (mapping_ != nullptr) { munmap(mapping_, mapping_size_); }
+  #endif
+}
+
+// =================================================================================================
+
+// Starts reading a range from disk in the background
+void MappedFile::Prefetch(const size_t offset, const size_t size) const {
+  #ifndef _WIN32
+    Advise(offset, size, MADV_WILLNEED);
+  #else
+    (void) offset; (void) size;
+  #endif
+}
+
+// Drops a range from host memory. The pages are clean, they are simply read again when needed.
+void MappedFile::Release(const size_t offset, const size_t size) const {
+  #ifndef _WIN32
+    Advise(offset, size, MADV_DONTNEED);
+  #else
+    (void) offset; (void) size;
+  #endif
+}
+
+// Advice has to be given for whole pages within the mapping. Pages which are only partly in the
+// range are not released, since the remainder might still be in use.
+void MappedFile::Advise(const size_t offset, const size_t size, const int advice) const {
+  #ifndef _WIN32
+    if (mapping_ == nullptr || size == 0) { return; }
+    auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto start = static_cast<size_t>(data_ - static_cast<const unsigned char*>(mapping_)) + offset;
+    auto end = std::min(start + size, mapping_size_);
+    if (advice == MADV_DONTNEED) {
+      start = ((start + page_size - 1) / page_size) * page_size;
+      if (end != mapping_size_) { end = (end / page_size) * page_size; }
+    }
+    else {
+      start = (start / page_size) * page_size;
+    }
+    if (end <= start) { return; }
+    madvise(static_cast<unsigned char*>(mapping_) + start, end - start, advice);
+  #else
+    (void) offset; (void) size; (void) advice;
+  #endif
+}
+
+// =================================================================================================
+} // namespace cltune
@@ -0,0 +1,158 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the PerfCounters class (see the header for information about the class).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/perf_counters.h"
+
+#include <algorithm> // std::max
+#include <cstdlib> // atoi
+
+#ifdef __linux__
+  #include <linux/perf_event.h> // perf_event_attr, PERF_*
+  #include <sys/syscall.h> // syscall, __NR_perf_event_open
+  #include <sys/ioctl.h> // ioctl
+  #include <unistd.h> // read, close
+  #include <dirent.h> // opendir, readdir, closedir
+#endif
+
+namespace cltune {
+// =================================================================================================
+
+#ifdef __linux__
+
+// Opens a counter of user-space events of a thread. Group leaders start disabled, the other
+// counters follow their leader.
+static int OpenCounter(const unsigned int type, const uint64_t config, const pid_t thread,
+                       const int leader) {
+  auto attributes = perf_event_attr{};
+  attributes.size = sizeof(attributes);
+  attributes.type = type;
+  attributes.config = config;
+  attributes.disabled = (leader == -1) ? 1 : 0;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attributes, thread, -1, leader, 0));
+}
+
+#endif
+
+// =================================================================================================
+
+// The last-level cache misses are the generic cache-miss event of the kernel, which is defined as
+// such on most processors
+PerfCounters::PerfCounters(const uint64_t vector_event):
+    events_(),
+    groups_() {
+  #ifdef __linux__
+    events_.push_back({PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES});
+    events_.push_back({PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS});
+    events_.push_back({PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES});
+    events_.push_back({PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES});
+    if (vector_event != 0) { events_.push_back({PERF_TYPE_RAW, vector_event}); }
+  #else
+    static_cast<void>(vector_event);
+  #endif
+}
+
+PerfCounters::~PerfCounters() {
+  Close();
+}
+
+// =================================================================================================
+
+// Lists the threads of the process and opens a group of counters on each. Threads on which the
+// first counter (cycles) cannot be opened are skipped, as are other unsupported events.
+bool PerfCounters::Start() {
+  Close();
+  #ifdef __linux__
+    auto directory = opendir("/proc/self/task");
+    if (directory == nullptr) { return false; }
+    while (auto entry = readdir(directory)) {
+      if (entry->d_name[0] == '.') { continue; }
+      auto thread = static_cast<pid_t>(atoi(entry->d_name));
+      auto group = Group{};
+      for (auto e = size_t{0}; e < events_.size(); ++e) {
+        auto leader = (group.descriptors.empty()) ? -1 : group.descriptors.front();
+        auto descriptor = OpenCounter(events_[e].first, events_[e].second, thread, leader);
+        if (descriptor < 0) {
+          if (e == 0) { break; }
+          continue;
+        }
+        group.descriptors.push_back(descriptor);
+        group.events.push_back(e);
+      }
+      if (!group.descriptors.empty()) { groups_.push_back(group); }
+    }
+    closedir(directory);
+    for (auto &group: groups_) {
+      ioctl(group.descriptors.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  #endif
+  return !groups_.empty();
+}
+
+// Reading a group leader returns the number of counters followed by all their values
+void PerfCounters::Stop(HardwareCounters &counters, const size_t num_runs) {
+  #ifdef __linux__
+    auto counts = std::vector<uint64_t>(kNumEvents, 0);
+    for (auto &group: groups_) {
+      auto leader = group.descriptors.front();
+      ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+      auto values = std::vector<uint64_t>(group.descriptors.size() + 1);
+      auto bytes = static_cast<ssize_t>(values.size() * sizeof(uint64_t));
+      if (read(leader, values.data(), static_cast<size_t>(bytes)) != bytes) { continue; }
+      for (auto i = size_t{0}; i < group.events.size(); ++i) {
+        counts[group.events[i]] += values[i + 1];
+      }
+    }
+    auto divisor = static_cast<uint64_t>(std::max(num_runs, size_t{1}));
+    counters.cycles += counts[0] / divisor;
+    counters.instructions += counts[1] / divisor;
+    counters.llc_misses += counts[2] / divisor;
+    counters.branch_misses += counts[3] / divisor;
+    counters.vector_instructions += counts[4] / divisor;
+  #else
+    static_cast<void>(counters);
+    static_cast<void>(num_runs);
+  #endif
+  Close();
+}
+
+// =================================================================================================
+
+void PerfCounters::Close() {
+  #ifdef __linux__
+    for (auto &group: groups_) {
+      for (auto descriptor: group.descriptors) { close(descriptor); }
+    }
+  #endif
+  groups_.clear();
+}
+
+// =================================================================================================
+} // namespace cltune
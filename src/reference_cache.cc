@@ -0,0 +1,205 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the ReferenceOutputs and ReferenceCache classes (see the header for
+// information about these classes).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/reference_cache.h"
+
+// For output formatting messages
+#include "internal/tuner_impl.h"
+
+#include <fstream> // std::ofstream
+#include <cstring> // std::memcmp
+#include <cstdio> // std::rename, std::remove, snprintf
+#include <stdexcept> // std::runtime_error
+
+#ifdef _WIN32
+  #include <process.h> // _getpid
+#else
+  #include <unistd.h> // getpid
+#endif
+
+namespace cltune {
+// =================================================================================================
+
+// Identifies a cache file ("CLTUNREF" in ASCII)
+constexpr auto kMagic = uint64_t{0x434C54554E524546ULL};
+
+// Rounds a file offset up to the alignment of the outputs
+size_t AlignOffset(const size_t offset) {
+  const auto alignment = ReferenceOutputs::kAlignment;
+  return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+// Parses a cache file: checks the key and sets the pointers to the outputs within the file. Returns
+// false if the file is not a valid cache file for the given key.
+bool ParseCacheFile(const unsigned char* file, const size_t size, const std::string &key,
+                    std::vector<const void*> &data, std::vector<size_t> &sizes) {
+  if (size < 3 * sizeof(uint64_t)) { return false; }
+  auto header = reinterpret_cast<const uint64_t*>(file);
+  auto num_outputs = static_cast<size_t>(header[2]);
+  if (header[0] != kMagic || header[1] != key.size()) { return false; }
+  if (num_outputs > size / sizeof(uint64_t)) { return false; }
+  auto offset = (3 + num_outputs) * sizeof(uint64_t);
+  if (offset + key.size() > size) { return false; }
+  if (std::memcmp(file + offset, key.data(), key.size()) != 0) { return false; }
+  offset = AlignOffset(offset + key.size());
+  for (auto i = size_t{0}; i < num_outputs; ++i) {
+    auto output_size = static_cast<size_t>(header[3 + i]);
+    if (offset + output_size > size) { return false; }
+    data.push_back(file + offset);
+    sizes.push_back(output_size);
+    offset = AlignOffset(offset + output_size);
+  }
+  return true;
+}
+
+// =================================================================================================
+
+// 64-bit FNV-1a hash
+uint64_t HashBytes(const void* data, const size_t size, const uint64_t hash) {
+  const auto kPrime = uint64_t{1099511628211ULL};
+  auto bytes = static_cast<const unsigned char*>(data);
+  auto result = hash;
+  for (auto i = size_t{0}; i < size; ++i) {
+    result ^= bytes[i];
+    result *= kPrime;
+  }
+  return result;
+}
+
+// =================================================================================================
+
+// Initializes an empty set of outputs
+ReferenceOutputs::ReferenceOutputs():
+    buffers_(),
+    file_(nullptr),
+    data_(),
+    sizes_() {
+}
+
+// Adds a new in-memory output
+void* ReferenceOutputs::AddOutput(const size_t size) {
+  buffers_.push_back(std::vector<unsigned char>(size));
+  data_.push_back(buffers_.back().data());
+  sizes_.push_back(size);
+  return buffers_.back().data();
+}
+
+// Maps a cache file into memory and checks whether it was stored for the given key
+std::shared_ptr<ReferenceOutputs> ReferenceOutputs::Load(const std::string &filename,
+                                                         const std::string &key) {
+  auto outputs = std::make_shared<ReferenceOutputs>();
+  try {
+    outputs->file_.reset(new MappedFile(filename));
+  } catch (std::runtime_error&) {
+    return nullptr; // Not in the cache
+  }
+  auto &file = *outputs->file_;
+  if (!ParseCacheFile(file.data(), file.size(), key, outputs->data_, outputs->sizes_)) {
+    return nullptr;
+  }
+  return outputs;
+}
+
+// Writes the header, the key, and the outputs (each aligned) into a cache file
+void ReferenceOutputs::Save(const std::string &filename, const std::string &key) const {
+  #ifdef _WIN32
+    auto temporary = filename + "." + std::to_string(_getpid()) + ".tmp";
+  #else
+    auto temporary = filename + "." + std::to_string(getpid()) + ".tmp";
+  #endif
+  auto file = std::ofstream(temporary, std::ios::binary);
+  if (!file) { throw std::runtime_error("Could not write reference cache file: " + temporary); }
+
+  // Writes the data, padding the outputs up to the alignment
+  auto header = std::vector<uint64_t>{kMagic, key.size(), NumOutputs()};
+  for (auto &size: sizes_) { header.push_back(size); }
+  auto offset = header.size() * sizeof(uint64_t) + key.size();
+  auto padding = std::vector<char>(kAlignment, 0);
+  file.write(reinterpret_cast<const char*>(header.data()), header.size() * sizeof(uint64_t));
+  file.write(key.data(), key.size());
+  for (auto i = size_t{0}; i < NumOutputs(); ++i) {
+    file.write(padding.data(), AlignOffset(offset) - offset);
+    file.write(static_cast<const char*>(data_[i]), sizes_[i]);
+    offset = AlignOffset(offset) + sizes_[i];
+  }
+  file.close();
+
+  // Moves the complete file into place
+  if (file.fail() || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("Could not write reference cache file: " + filename);
+  }
+}
+
+// =================================================================================================
+
+// Initializes an in-memory cache
+ReferenceCache::ReferenceCache():
+    directory_(),
+    entries_() {
+}
+
+// Sets the directory for the on-disk cache
+void ReferenceCache::SetDirectory(const std::string &directory) {
+  directory_ = directory;
+}
+
+// Looks for the outputs in memory first and on disk second
+std::shared_ptr<const ReferenceOutputs> ReferenceCache::Find(const std::string &key) {
+  auto entry = entries_.find(key);
+  if (entry != entries_.end()) { return entry->second; }
+  if (directory_.empty()) { return nullptr; }
+  auto outputs = ReferenceOutputs::Load(FileName(key), key);
+  if (outputs) { entries_[key] = outputs; }
+  return outputs;
+}
+
+// Stores the outputs in memory and on disk. Failing to write the cache file is not fatal: it only
+// means that the next tuning session has to run the reference again.
+void ReferenceCache::Store(const std::string &key,
+                           const std::shared_ptr<const ReferenceOutputs> &outputs) {
+  entries_[key] = outputs;
+  if (directory_.empty()) { return; }
+  try {
+    outputs->Save(FileName(key), key);
+  } catch (std::exception &e) {
+    fprintf(stdout, "%s %s\n", TunerImpl::kMessageWarning.c_str(), e.what());
+  }
+}
+
+// The file name is based on a hash of the key, the key itself is stored in the file as well
+std::string ReferenceCache::FileName(const std::string &key) const {
+  char hash[17];
+  snprintf(hash, sizeof(hash), "%016llx",
+           static_cast<unsigned long long>(HashBytes(key.data(), key.size())));
+  return directory_ + "/cltune_reference_" + std::string{hash} + ".bin";
+}
+
+// =================================================================================================
+} // namespace cltune
@@ -29,6 +29,7 @@
 #include "internal/searcher.h"
 
 #include <limits>
+#include <algorithm>
 
 namespace cltune {
 // =================================================================================================
@@ -38,7 +39,9 @@ Searcher::Searcher(const Configurations &configurations):
     configurations_(configurations),
     execution_times_(configurations.size(), std::numeric_limits<double>::max()),
     explored_indices_(),
-    index_(0) {
+    index_(0),
+    objectives_(configurations.size()),
+    pareto_front_() {
 }
 
 // Adds the resulting execution time to the back of the execution times vector. Also stores the
@@ -48,6 +51,23 @@ void Searcher::PushExecutionTime(const double execution_time) {
   execution_times_[index_] = execution_time;
 }
 
+// Adds the configuration to the Pareto front unless it is dominated, and removes the configurations
+// which it dominates. Configurations with equal objectives are all kept.
+void Searcher::PushObjectives(const std::vector<double> &objectives) {
+  objectives_[index_] = objectives;
+  if (objectives.empty()) { return; }
+  for (auto &front_index: pareto_front_) {
+    if (front_index == index_) { return; }
+    if (Dominates(objectives_[front_index], objectives)) { return; }
+  }
+  auto dominated = [this, &objectives](const size_t front_index) {
+    return Dominates(objectives, objectives_[front_index]);
+  };
+  pareto_front_.erase(std::remove_if(pareto_front_.begin(), pareto_front_.end(), dominated),
+                      pareto_front_.end());
+  pareto_front_.push_back(index_);
+}
+
 // Prints the explored indices and the corresponding execution times to a log(file)
 void Searcher::PrintLog(FILE* fp) const {
   fprintf(fp, "step;index;time\n");
@@ -58,5 +78,86 @@ void Searcher::PrintLog(FILE* fp) const {
   }
 }
 
+// =================================================================================================
+
+// Collects the configurations corresponding to the upcoming independent indices
+std::vector<KernelInfo::Configuration> Searcher::GetBatch(const size_t max_size) const {
+  auto batch = std::vector<KernelInfo::Configuration>();
+  for (auto &index: NextIndices(max_size)) {
+    batch.push_back(configurations_[index]);
+  }
+  return batch;
+}
+
+// Pushes the results of a batch one-by-one, exactly as the tuner does in its sequential loop
+void Searcher::PushBatch(const std::vector<double> &execution_times,
+                         const std::vector<std::vector<double>> &objectives) {
+  TRACE_SPAN("searcher", "PushBatch");
+  for (auto i = size_t{0}; i < execution_times.size(); ++i) {
+    GetConfiguration();
+    if (i < objectives.size()) { PushObjectives(objectives[i]); }
+    PushExecutionTime(execution_times[i]);
+    CalculateNextIndex();
+  }
+}
+
+// =================================================================================================
+
+bool Searcher::Dominates(const std::vector<double> &a, const std::vector<double> &b) {
+  auto better = false;
+  for (auto i = size_t{0}; i < a.size() && i < b.size(); ++i) {
+    if (a[i] > b[i]) { return false; }
+    if (a[i] < b[i]) { better = true; }
+  }
+  return better;
+}
+
+// Empty points (failures) are never part of the front
+std::vector<size_t> Searcher::ParetoFront(const std::vector<std::vector<double>> &points) {
+  auto front = std::vector<size_t>();
+  for (auto i = size_t{0}; i < points.size(); ++i) {
+    if (points[i].empty()) { continue; }
+    auto dominated = false;
+    for (auto j = size_t{0}; j < points.size() && !dominated; ++j) {
+      dominated = !points[j].empty() && Dominates(points[j], points[i]);
+    }
+    if (!dominated) { front.push_back(i); }
+  }
+  return front;
+}
+
+// Moves the starting points to the front, such that searchers which visit the configurations in
+// order evaluate them first
+void Searcher::SetStartingPoints(const Configurations &points) {
+  auto front = size_t{0};
+  for (auto &point: points) {
+    auto index = IndexOf(point);
+    if (index == configurations_.size() || index < front) { continue; } // Unknown or a duplicate
+    std::swap(configurations_[front], configurations_[index]);
+    ++front;
+  }
+}
+
+// =================================================================================================
+
+// Only the current configuration is known to be independent of any feedback
+std::vector<size_t> Searcher::NextIndices(const size_t) const {
+  return std::vector<size_t>{index_};
+}
+
+// Compares the values of the parameters, which are in the same order in all configurations
+size_t Searcher::IndexOf(const KernelInfo::Configuration &target) const {
+  for (auto index = size_t{0}; index < configurations_.size(); ++index) {
+    auto &configuration = configurations_[index];
+    if (configuration.size() != target.size()) { continue; }
+    auto num_matches = size_t{0};
+    for (auto i=size_t{0}; i<configuration.size(); ++i) {
+      if (configuration[i].value == target[i].value) { num_matches++; }
+    }
+    if (num_matches == configuration.size()) { return index; }
+  }
+  return configurations_.size();
+}
+
 // =================================================================================================
 } // namespace cltune
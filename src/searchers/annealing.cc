@@ -66,6 +66,7 @@ KernelInfo::Configuration Annealing::GetConfiguration() {
 // a random neighbour of the new state. If the newly calculated neighbour is already visited, this
 // function is called recursively until some maximum number of calls has been reached.
 void Annealing::CalculateNextIndex() {
+  TRACE_SPAN("searcher", "Annealing::CalculateNextIndex");
 
   // Computes the new temperature
   auto progress = num_visited_states_ / static_cast<double>(NumConfigurations());
@@ -114,6 +115,18 @@ void Annealing::PushExecutionTime(const double execution_time) {
   execution_times_[index_] = execution_time;
 }
 
+// Uses the first starting point which is in the search space
+void Annealing::SetStartingPoints(const Configurations &points) {
+  for (auto &point: points) {
+    auto index = IndexOf(point);
+    if (index < configurations_.size()) {
+      current_state_ = index;
+      index_ = index;
+      return;
+    }
+  }
+}
+
 // =================================================================================================
 
 // Retrieves the neighbours IDs of a configuration identified by a reference ID. This searches
@@ -45,6 +45,7 @@ KernelInfo::Configuration FullSearch::GetConfiguration() {
 
 // Calculates the index of the next configuration to test
 void FullSearch::CalculateNextIndex() {
+  TRACE_SPAN("searcher", "FullSearch::CalculateNextIndex");
   ++index_;
 }
 
@@ -53,5 +54,14 @@ size_t FullSearch::NumConfigurations() {
   return configurations_.size();
 }
 
+// Returns the next 'max_size' indices, since these do not depend on any feedback
+std::vector<size_t> FullSearch::NextIndices(const size_t max_size) const {
+  auto indices = std::vector<size_t>();
+  for (auto index = index_; index < configurations_.size() && indices.size() < max_size; ++index) {
+    indices.push_back(index);
+  }
+  return indices;
+}
+
 // =================================================================================================
 } // namespace cltune
@@ -69,6 +69,7 @@ KernelInfo::Configuration PSO::GetConfiguration() {
 
 // Computes the next position of the current particle in the swarm. This is based on probabilities.
 void PSO::CalculateNextIndex() {
+  TRACE_SPAN("searcher", "PSO::CalculateNextIndex");
 
   // Calculates the next state of the current swarm. This next state could be an invalid
   // configuration, so the next block is put in a do-while loop and only ends when a valid next
@@ -96,7 +97,7 @@ void PSO::CalculateNextIndex() {
       }
       // Else: stay at current location
     }
-    new_index = IndexFromConfiguration(next_configuration);
+    new_index = IndexOf(next_configuration);
   } while (new_index >= configurations_.size());
   particle_positions_[particle_index_] = new_index;
 
@@ -128,23 +129,27 @@ void PSO::PushExecutionTime(const double execution_time) {
   }
 }
 
-// =================================================================================================
-
-// Searches all configuration to find which configuration is the 'target' (argument to this
-// function). The target's index in the total configuration vector is returned.
-size_t PSO::IndexFromConfiguration(const KernelInfo::Configuration target) const {
-  auto config_index = size_t{0};
-  for (auto &configuration: configurations_) {
-    auto num_matches = size_t{0};
-    for (auto i=size_t{0}; i<configuration.size(); ++i) {
-      if (configuration[i].value == target[i].value) { num_matches++; }
-    }
-    if (num_matches == configuration.size()) { return config_index; }
-    ++config_index;
+// Returns the positions of the particles which are not yet evaluated in the current sweep over the
+// swarm. These only move after their own evaluation, so they can be evaluated concurrently.
+std::vector<size_t> PSO::NextIndices(const size_t max_size) const {
+  auto indices = std::vector<size_t>();
+  for (auto particle = particle_index_; particle < swarm_size_ && indices.size() < max_size;
+       ++particle) {
+    indices.push_back(particle_positions_[particle]);
   }
+  return indices;
+}
 
-  // No match is found: this is an invalid configuration
-  return config_index;
+// The starting points replace the random initial positions of the first particles (best first), the
+// remaining particles keep exploring from random positions
+void PSO::SetStartingPoints(const Configurations &points) {
+  auto particle = size_t{0};
+  for (auto &point: points) {
+    if (particle == swarm_size_) { break; }
+    auto index = IndexOf(point);
+    if (index < configurations_.size()) { particle_positions_[particle++] = index; }
+  }
+  index_ = particle_positions_[particle_index_];
 }
 
 // =================================================================================================
@@ -51,6 +51,7 @@ KernelInfo::Configuration RandomSearch::GetConfiguration() {
 
 // Calculates the index of the next configuration to test
 void RandomSearch::CalculateNextIndex() {
+  TRACE_SPAN("searcher", "RandomSearch::CalculateNextIndex");
   ++index_;
 }
 
@@ -59,5 +60,14 @@ size_t RandomSearch::NumConfigurations() {
   return std::max(size_t{1}, static_cast<size_t>(configurations_.size()*fraction_));
 }
 
+// Returns the next 'max_size' indices, since these do not depend on any feedback
+std::vector<size_t> RandomSearch::NextIndices(const size_t max_size) const {
+  auto indices = std::vector<size_t>();
+  for (auto index = index_; index < configurations_.size() && indices.size() < max_size; ++index) {
+    indices.push_back(index);
+  }
+  return indices;
+}
+
 // =================================================================================================
 } // namespace cltune
@@ -0,0 +1,97 @@
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the TimeLimitedTasks class (see the header for information about the class).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/time_limited_tasks.h"
+
+#include <chrono> // std::chrono::duration
+#include <utility> // std::move
+
+namespace cltune {
+// =================================================================================================
+
+TimeLimitedTasks::TimeLimitedTasks(const size_t max_abandoned):
+    max_abandoned_((max_abandoned == 0) ? 1 : max_abandoned),
+    abandoned_() {
+}
+
+TimeLimitedTasks::~TimeLimitedTasks() {
+  for (auto &task: abandoned_) { task.thread.join(); }
+}
+
+// =================================================================================================
+
+// The task's future reports both its completion and its exceptions. Only after abandoning a task,
+// the oldest abandoned tasks are waited for if there are too many.
+bool TimeLimitedTasks::Run(std::function<void()> task, const float limit_ms) {
+  auto packaged_task = std::packaged_task<void()>(std::move(task));
+  auto done = packaged_task.get_future();
+  auto thread = std::thread(std::move(packaged_task));
+  auto limit = std::chrono::duration<float, std::milli>(limit_ms);
+  if (done.wait_for(limit) == std::future_status::timeout) {
+    abandoned_.push_back(Abandoned{std::move(thread), std::move(done)});
+    WaitUntilAtMost(max_abandoned_);
+    return false;
+  }
+  thread.join();
+  done.get();
+  return true;
+}
+
+void TimeLimitedTasks::WaitForSlot() {
+  WaitUntilAtMost(max_abandoned_ - 1);
+}
+
+size_t TimeLimitedTasks::NumAbandoned() {
+  RemoveFinished();
+  return abandoned_.size();
+}
+
+// =================================================================================================
+
+// Only blocks when more than 'num_tasks' abandoned tasks are still running
+void TimeLimitedTasks::WaitUntilAtMost(const size_t num_tasks) {
+  RemoveFinished();
+  while (abandoned_.size() > num_tasks) {
+    abandoned_.front().thread.join();
+    abandoned_.pop_front();
+  }
+}
+
+void TimeLimitedTasks::RemoveFinished() {
+  for (auto it = abandoned_.begin(); it != abandoned_.end(); ) {
+    if (it->done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      it->thread.join();
+      it = abandoned_.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+// =================================================================================================
+} // namespace cltune
@@ -0,0 +1,127 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the Trace class (see the header for information about the class).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/trace.h"
+
+#include <vector> // std::vector
+#include <map> // std::map
+#include <mutex> // std::mutex, std::lock_guard
+#include <thread> // std::this_thread::get_id
+#include <chrono> // std::chrono::steady_clock
+#include <cstdio> // fopen, fprintf
+#include <stdexcept> // std::runtime_error
+
+namespace cltune {
+// =================================================================================================
+
+// The recorded spans. Host threads are numbered in order of their first span, the device is a
+// separate process in the trace.
+struct TraceSpanData {
+  const char* category;
+  std::string name;
+  double start;
+  double end;
+  size_t thread;
+  bool device;
+};
+struct TraceData {
+  std::mutex mutex;
+  std::chrono::steady_clock::time_point epoch;
+  std::vector<TraceSpanData> spans;
+  std::map<std::thread::id, size_t> threads;
+};
+
+// The trace data of the process, created at first use (which marks the start of the trace)
+static TraceData& Data() {
+  static TraceData data{{}, std::chrono::steady_clock::now(), {}, {}};
+  return data;
+}
+
+// Escapes a string for use in JSON: quotes and backslashes, control characters are left out
+static std::string Escape(const std::string &text) {
+  auto result = std::string{};
+  for (auto character: text) {
+    if (character == '"' || character == '\\') { result += '\\'; }
+    if (static_cast<unsigned char>(character) >= 0x20) { result += character; }
+  }
+  return result;
+}
+
+// =================================================================================================
+
+double Trace::Now() {
+  auto elapsed = std::chrono::steady_clock::now() - Data().epoch;
+  return std::chrono::duration<double, std::micro>(elapsed).count();
+}
+
+void Trace::AddSpan(const char* category, const std::string &name, const double start,
+                    const double end) {
+  auto &data = Data();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  auto thread = data.threads.emplace(std::this_thread::get_id(), data.threads.size()).first;
+  data.spans.push_back(TraceSpanData{category, name, start, end, thread->second, false});
+}
+
+void Trace::AddDeviceSpan(const std::string &name, const double start, const double end) {
+  auto &data = Data();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  data.spans.push_back(TraceSpanData{"device", name, start, end, 0, true});
+}
+
+// The device clock has an arbitrary origin: the timestamps are taken relative to the moment the
+// kernel was queued, which is (approximately) the host time of the enqueue call
+void Trace::AddDeviceEvent(const std::string &name, const double enqueue_time,
+                           const std::vector<unsigned long long> &timestamps) {
+  auto start = enqueue_time + static_cast<double>(timestamps[2] - timestamps[0]) * 1.0e-3;
+  auto end = enqueue_time + static_cast<double>(timestamps[3] - timestamps[0]) * 1.0e-3;
+  AddDeviceSpan(name, start, end);
+}
+
+// Writes the spans as complete ("X") events, preceded by the names of the processes
+void Trace::Save(const std::string &filename) {
+  auto &data = Data();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  auto file = fopen(filename.c_str(), "w");
+  if (file == nullptr) { throw std::runtime_error("Could not open trace file: " + filename); }
+  fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  fprintf(file, "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": 0, "
+                "\"args\": {\"name\": \"tuner\"}},\n");
+  fprintf(file, "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, "
+                "\"args\": {\"name\": \"device\"}}");
+  for (auto &span: data.spans) {
+    fprintf(file, ",\n  {\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3lf, "
+                  "\"dur\": %.3lf, \"pid\": %d, \"tid\": %zu}",
+            Escape(span.name).c_str(), span.category, span.start, span.end - span.start,
+            span.device ? 1 : 0, span.thread);
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+}
+
+// =================================================================================================
+} // namespace cltune
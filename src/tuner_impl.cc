@@ -38,12 +38,24 @@
 #include "internal/ml_models/linear_regression.h"
 #include "internal/ml_models/neural_network.h"
 
+// The built-in input generator kernel
+#include "internal/input_generator.h"
+#include "internal/trace.h"
+
 #include <fstream> // std::ifstream, std::stringstream
 #include <iostream> // FILE
 #include <limits> // std::numeric_limits
-#include <algorithm> // std::min
+#include <algorithm> // std::min, std::sort, std::shuffle
 #include <memory> // std::unique_ptr
 #include <tuple> // std::tuple
+#include <cstdlib> // getenv
+#include <chrono> // std::chrono::steady_clock
+#include <thread> // std::this_thread::sleep_for
+#include <future> // std::async
+#include <random> // std::default_random_engine, std::uniform_int_distribution
+#include <cmath> // std::ceil, std::log, std::pow
+#include <cstring> // std::memcpy
+#include <utility> // std::swap
 
 namespace cltune {
 // =================================================================================================
@@ -82,12 +94,50 @@ TunerImpl::TunerImpl():
     context_(Context(device_)),
     queue_(Queue(context_, device_)),
     num_runs_(size_t{1}),
+    run_statistic_(RunStatistic::kMinimum),
+    run_statistic_parameter_(0.0),
+    background_threads_(0),
     has_reference_(false),
     verification_method_(VerificationMethod::AbsoluteDifference),
     tolerance_treshold_(kMaxL2Norm),
     suppress_output_(false),
     output_search_process_(false),
-    search_log_filename_(std::string{}) {
+    search_log_filename_(std::string{}),
+    buffer_memory_(device_.IsCPU() ? BufferMemory::kHost : BufferMemory::kDevice),
+    generator_programs_(),
+    memory_budget_(0),
+    timing_metric_(TimingMetric::kKernel),
+    perf_counters_(nullptr),
+    energy_meter_(nullptr),
+    objective_weights_(1, {Objective::kTime, 1.0}),
+    objective_constraints_(),
+    pareto_objectives_(),
+    drift_sentinels_(),
+    drift_events_(),
+    drift_(1.0f),
+    platform_id_(0),
+    device_id_(0),
+    sweep_kernel_(),
+    sweep_intervals_(),
+    warm_starts_(),
+    distributed_address_(std::string{}),
+    num_local_workers_(0),
+    max_worker_losses_(Coordinator::kMaxLosses),
+    worker_timeout_ms_(0.0f),
+    coordinator_(nullptr),
+    worker_finished_(false),
+    compile_timeout_ms_(0.0f),
+    run_timeout_ms_(0.0f),
+    relative_timeout_(0.0f),
+    best_time_(std::numeric_limits<float>::max()),
+    builds_(kMaxAbandonedBuilds),
+    verify_top_k_(0),
+    audit_fraction_(0.0),
+    detection_probability_(1.0),
+    error_fraction_(0.0),
+    sample_generator_(),
+    staging_buffers_(kStagingBuffers),
+    next_staging_buffer_(0) {
   if (!suppress_output_) {
     fprintf(stdout, "\n%s Initializing on platform 0 device 0\n", kMessageFull.c_str());
     auto opencl_version = device_.Version();
@@ -104,12 +154,50 @@ TunerImpl::TunerImpl(size_t platform_id, size_t device_id):
     context_(Context(device_)),
     queue_(Queue(context_, device_)),
     num_runs_(size_t{1}),
+    run_statistic_(RunStatistic::kMinimum),
+    run_statistic_parameter_(0.0),
+    background_threads_(0),
     has_reference_(false),
     verification_method_(VerificationMethod::AbsoluteDifference),
     tolerance_treshold_(kMaxL2Norm),
     suppress_output_(false),
     output_search_process_(false),
-    search_log_filename_(std::string{}) {
+    search_log_filename_(std::string{}),
+    buffer_memory_(device_.IsCPU() ? BufferMemory::kHost : BufferMemory::kDevice),
+    generator_programs_(),
+    memory_budget_(0),
+    timing_metric_(TimingMetric::kKernel),
+    perf_counters_(nullptr),
+    energy_meter_(nullptr),
+    objective_weights_(1, {Objective::kTime, 1.0}),
+    objective_constraints_(),
+    pareto_objectives_(),
+    drift_sentinels_(),
+    drift_events_(),
+    drift_(1.0f),
+    platform_id_(platform_id),
+    device_id_(device_id),
+    sweep_kernel_(),
+    sweep_intervals_(),
+    warm_starts_(),
+    distributed_address_(std::string{}),
+    num_local_workers_(0),
+    max_worker_losses_(Coordinator::kMaxLosses),
+    worker_timeout_ms_(0.0f),
+    coordinator_(nullptr),
+    worker_finished_(false),
+    compile_timeout_ms_(0.0f),
+    run_timeout_ms_(0.0f),
+    relative_timeout_(0.0f),
+    best_time_(std::numeric_limits<float>::max()),
+    builds_(kMaxAbandonedBuilds),
+    verify_top_k_(0),
+    audit_fraction_(0.0),
+    detection_probability_(1.0),
+    error_fraction_(0.0),
+    sample_generator_(),
+    staging_buffers_(kStagingBuffers),
+    next_staging_buffer_(0) {
   if (!suppress_output_) {
     fprintf(stdout, "\n%s Initializing on platform %zu device %zu\n",
             kMessageFull.c_str(), platform_id, device_id);
@@ -122,19 +210,8 @@ TunerImpl::TunerImpl(size_t platform_id, size_t device_id):
 
 // End of the tuner
 TunerImpl::~TunerImpl() {
-  for (auto &reference_output: reference_outputs_) {
-    delete[] static_cast<int*>(reference_output);
-  }
-
   // Frees the device buffers
-  auto free_buffers = [](KernelInfo::MemArgument &mem_info) {
-    #ifdef USE_OPENCL
-      CheckError(clReleaseMemObject(mem_info.buffer));
-    #else
-      CheckError(cuMemFree(mem_info.buffer));
-    #endif
-  };
-  for (auto &mem_argument: arguments_output_copy_) { free_buffers(mem_argument); }
+  for (auto &mem_argument: arguments_output_copy_) { FreeBuffer(mem_argument.buffer); }
 
   if (!suppress_output_) {
     fprintf(stdout, "\n%s End of the tuning process\n\n", kMessageFull.c_str());
@@ -147,6 +224,7 @@ TunerImpl::~TunerImpl() {
 PublicTunerResult TunerImpl::RunSingleKernel(const size_t id, const ParameterRange &parameter_values) {
   KernelInfo& kernel = kernels_.at(id);
   KernelInfo::Configuration configuration;
+  auto source = kernel.source();
 
   PrintHeader("Running kernel " + kernel.name());
 
@@ -159,17 +237,18 @@ PublicTunerResult TunerImpl::RunSingleKernel(const size_t id, const ParameterRan
     }
 
     // Adds the parameters to the source-code string as defines
-    std::string source = GetConfiguredKernelSource(id, configuration);
+    source = GetConfiguredKernelSource(id, configuration);
 
     // Updates the local range with the parameter values
     kernel.ComputeRanges(configuration);
 
-    // Updates number of kernel iterations based on parameter value
+    // Updates number of kernel iterations and streamed chunks based on parameter values
     kernel.SetNumCurrentIterations(configuration);
+    kernel.SetNumCurrentChunks(configuration);
   }
 
   // Compiles and runs the kernel
-  auto tuning_result = RunKernel(kernel.source(), kernel, 0, 1);
+  auto tuning_result = RunKernel(source, kernel, 0, 1);
   tuning_result.status = VerifyOutput();
 
   if (parameter_values.size() > 0) {
@@ -192,6 +271,23 @@ PublicTunerResult TunerImpl::RunSingleKernel(const size_t id, const ParameterRan
 
 std::vector<PublicTunerResult> TunerImpl::TuneSingleKernel(const size_t id, const bool test_reference,
                                                            const bool clear_previous_results) {
+  TRACE_SPAN("tuner", "TuneSingleKernel");
+
+  // Worker processes serve the coordinator instead of tuning by themselves
+  if (IsDistributedWorker()) {
+    ServeAsWorker();
+    return std::vector<PublicTunerResult>();
+  }
+  auto objectives = pareto_objectives_;
+  for (auto &weight: objective_weights_) { objectives.push_back(weight.first); }
+  for (auto &constraint: objective_constraints_) { objectives.push_back(constraint.first); }
+  for (auto &objective: objectives) {
+    auto is_energy = (objective == Objective::kEnergy || objective == Objective::kEnergyDelay);
+    if (is_energy && !energy_meter_) {
+      throw std::runtime_error("The energy objectives require energy measurement");
+    }
+  }
+
   if (clear_previous_results) {
     tuning_results_.clear();
   }
@@ -203,6 +299,7 @@ std::vector<PublicTunerResult> TunerImpl::TuneSingleKernel(const size_t id, cons
 
   KernelInfo& kernel = kernels_.at(id);
   PrintHeader("Testing kernel " + kernel.name());
+  best_time_ = std::numeric_limits<float>::max();
 
   // If there are no tuning parameters, simply run the kernel and store the results
   if (kernel.parameters().size() == 0) {
@@ -226,43 +323,83 @@ std::vector<PublicTunerResult> TunerImpl::TuneSingleKernel(const size_t id, cons
     // Creates the selected search algorithm
     std::unique_ptr<Searcher> searcher = GetSearcher(id);
 
-    // Iterates over all possible configurations (the permutations of the tuning parameters)
-    for (auto p = size_t{ 0 }; p < searcher->NumConfigurations(); ++p) {
-      #ifdef VERBOSE
-        fprintf(stdout, "%s Exploring configuration (%zu out of %zu)\n", kMessageVerbose.c_str(),
-                p + 1, search->NumConfigurations());
-      #endif
-      auto permutation = searcher->GetConfiguration();
-
-      // Adds the parameters to the source-code string as defines
-      std::string source = GetConfiguredKernelSource(id, permutation);
-
-      // Updates the local range with the parameter values
-      kernel.ComputeRanges(permutation);
-
-      // Updates number of kernel iterations based on parameter value
-      kernel.SetNumCurrentIterations(permutation);
-
-      // Compiles and runs the kernel
-      auto tuning_result = RunKernel(source, kernel, p, searcher->NumConfigurations());
-      tuning_result.status = VerifyOutput();
-
-      // Gives timing feedback to the search algorithm and calculates the next index
-      searcher->PushExecutionTime(tuning_result.time);
-      searcher->CalculateNextIndex();
-
-      // Stores the parameters and the timing-result
-      tuning_result.configuration = permutation;
-      if (tuning_result.time == std::numeric_limits<float>::max()) {
-        tuning_result.time = 0.0;
-        PrintResult(stdout, tuning_result, kMessageFailure);
-        tuning_result.time = std::numeric_limits<float>::max();
-        tuning_result.status = false;
+    // Lets the workers do the work in case of distributed tuning
+    if (!distributed_address_.empty()) {
+      TuneDistributed(id, *searcher);
+    }
+    else {
+      auto deferred_verification = (has_reference_ && verify_top_k_ > 0);
+      auto first_result = tuning_results_.size();
+
+      // The drift sentinel measures its baseline before the first configuration
+      auto sentinel = drift_sentinels_.find(id);
+      auto has_sentinel = (sentinel != drift_sentinels_.end());
+      auto last_check = tuning_results_.size();
+      drift_ = 1.0f;
+      if (has_sentinel) {
+        sentinel->second.baseline_time = RunBaseline(id, sentinel->second.baseline);
+        if (sentinel->second.baseline_time == std::numeric_limits<float>::max()) {
+          throw std::runtime_error("The baseline configuration of the drift sentinel failed");
+        }
       }
-      else if (!tuning_result.status) {
-        PrintResult(stdout, tuning_result, kMessageWarning);
+
+      // Iterates over all possible configurations (the permutations of the tuning parameters)
+      for (auto p = size_t{ 0 }; p < searcher->NumConfigurations(); ++p) {
+        #ifdef VERBOSE
+          fprintf(stdout, "%s Exploring configuration (%zu out of %zu)\n", kMessageVerbose.c_str(),
+                  p + 1, search->NumConfigurations());
+        #endif
+        if (has_sentinel && p > 0 && p % sentinel->second.interval == 0) {
+          CheckDrift(id, sentinel->second, p, last_check);
+          last_check = tuning_results_.size();
+        }
+        auto permutation = searcher->GetConfiguration();
+
+        // Adds the parameters to the source-code string as defines
+        std::string source = GetConfiguredKernelSource(id, permutation);
+
+        // Updates the local range with the parameter values
+        kernel.ComputeRanges(permutation);
+
+        // Updates number of kernel iterations and streamed chunks based on parameter values
+        kernel.SetNumCurrentIterations(permutation);
+        kernel.SetNumCurrentChunks(permutation);
+
+        // Compiles and runs the kernel
+        auto tuning_result = RunKernel(source, kernel, p, searcher->NumConfigurations());
+        // Normalizes all times of the result by the drift, such that they are consistent with each
+        // other. The raw device timestamps are kept as they are.
+        auto normalize = (has_sentinel && sentinel->second.action == DriftAction::kNormalize);
+        if (normalize && tuning_result.time != std::numeric_limits<float>::max()) {
+          tuning_result.time /= drift_;
+          tuning_result.timings.kernel /= drift_;
+          tuning_result.timings.submitted /= drift_;
+          tuning_result.timings.queued /= drift_;
+          tuning_result.timings.wall_clock /= drift_;
+          for (auto &run_time: tuning_result.run_times) { run_time /= drift_; }
+        }
+
+        // Gives timing feedback to the search algorithm and calculates the next index. The search
+        // algorithms only use the time, so they do not have to wait for the verification.
+        if (!pareto_objectives_.empty()) {
+          searcher->PushObjectives(ParetoObjectives(tuning_result));
+        }
+        searcher->PushExecutionTime(SearcherFeedback(tuning_result));
+        searcher->CalculateNextIndex();
+
+        // Verifies the output in the background and stores the parameters and the timing-result.
+        // In case of deferred verification, the result is stored as unverified and verified later.
+        tuning_result.configuration = permutation;
+        if (deferred_verification) {
+          tuning_result.unverified = true;
+          StoreResult(tuning_result);
+        }
+        else {
+          VerifyOutputAsync(tuning_result);
+        }
       }
-      tuning_results_.push_back(tuning_result);
+      while (!pending_verifications_.empty()) { FinishVerification(); }
+      if (deferred_verification) { VerifyDeferred(id, first_result); }
     }
 
     // Prints a log of the searching process. This is disabled per default, but can be enabled
@@ -290,6 +427,12 @@ std::vector<PublicTunerResult> TunerImpl::TuneSingleKernel(const size_t id, cons
 // parameters are computed for each kernel and those kernels are run. Their timing-results are
 // collected and stored into the tuning_results_ vector.
 std::vector<PublicTunerResult> TunerImpl::TuneAllKernels() {
+  // Worker processes serve the coordinator instead of tuning by themselves
+  if (IsDistributedWorker()) {
+    ServeAsWorker();
+    return std::vector<PublicTunerResult>();
+  }
+
   // Clears tuning results from previous runs
   tuning_results_.clear();
 
@@ -311,22 +454,135 @@ std::vector<PublicTunerResult> TunerImpl::TuneAllKernels() {
 
 // =================================================================================================
 
+// Evaluates the configurations in batches on the workers. Batches are as large as the number of
+// workers allows and as the search strategy can provide without feedback. The coordinator and its
+// local workers are started at the first call and are kept alive until the tuner is destroyed.
+void TunerImpl::TuneDistributed(const size_t id, Searcher &searcher) {
+  if (!coordinator_) {
+    PrintHeader("Starting distributed tuning on " + distributed_address_);
+    coordinator_.reset(new Coordinator(distributed_address_));
+    coordinator_->SetWatchdog(max_worker_losses_, worker_timeout_ms_);
+    coordinator_->SpawnLocalWorkers(num_local_workers_);
+  }
+  auto &kernel = kernels_.at(id);
+  auto num_configurations = searcher.NumConfigurations();
+  auto p = size_t{0};
+  while (p < num_configurations) {
+    auto num_workers = std::max(num_local_workers_, coordinator_->NumWorkers());
+    num_workers = std::max(num_workers, size_t{1});
+    auto batch = searcher.GetBatch(std::min(num_configurations - p, num_workers));
+    if (batch.empty()) { break; }
+    auto results = coordinator_->Evaluate(id, batch);
+
+    // Stores and prints the results in the same way as in the sequential case
+    auto execution_times = std::vector<double>();
+    auto objectives = std::vector<std::vector<double>>();
+    for (auto b = size_t{0}; b < batch.size(); ++b, ++p) {
+      auto confidence = (results[b].failure_reason.empty()) ? VerificationConfidence(kernel) : 0.0;
+      auto tuning_result = TunerResult{kernel.name(), results[b].time, results[b].threads,
+                                       results[b].status, batch[b], results[b].failure_reason,
+                                       results[b].timed_out, confidence, results[b].peak_memory,
+                                       RunTimings{results[b].timings[0], results[b].timings[1],
+                                                  results[b].timings[2], results[b].timings[3],
+                                                  0, 0, 0, 0},
+                                       HardwareCounters{0, 0, 0, 0, 0},
+                                       results[b].energy, results[b].power,
+                                       results[b].compile_time, results[b].local_memory,
+                                       std::vector<float>(1, results[b].time), 1.0f, false};
+      execution_times.push_back(SearcherFeedback(tuning_result));
+      objectives.push_back(ParetoObjectives(tuning_result));
+      if (!tuning_result.failure_reason.empty()) {
+        fprintf(stdout, "%s Kernel %s failed: %s\n", kMessageFailure.c_str(),
+                kernel.name().c_str(), tuning_result.failure_reason.c_str());
+      }
+      else {
+        fprintf(stdout, "%s Completed %s (%.1lf ms) - %zu out of %zu\n", kMessageOK.c_str(),
+                kernel.name().c_str(), tuning_result.time, p + 1, num_configurations);
+      }
+      StoreResult(tuning_result);
+    }
+    searcher.PushBatch(execution_times, objectives);
+  }
+}
+
+// Runs the reference kernel once and then the configurations sent by the coordinator, until the
+// coordinator has finished. Subsequent tuning calls in the worker process return immediately.
+void TunerImpl::ServeAsWorker() {
+  if (worker_finished_) { return; }
+  RunReferenceKernel();
+  auto worker = Worker(std::string{getenv(kWorkerAddressVariable)}, device_.Name());
+  auto sequence = size_t{0};
+  auto id = size_t{0};
+  auto configuration = KernelInfo::Configuration();
+  while (worker.Receive(sequence, id, configuration)) {
+    auto &kernel = kernels_.at(id);
+    auto source = GetConfiguredKernelSource(id, configuration);
+    kernel.ComputeRanges(configuration);
+    kernel.SetNumCurrentIterations(configuration);
+    kernel.SetNumCurrentChunks(configuration);
+    auto tuning_result = RunKernel(source, kernel, sequence, sequence + 1);
+    tuning_result.status = VerifyOutput() && !tuning_result.timed_out;
+    if (tuning_result.status) { best_time_ = std::min(best_time_, tuning_result.time); }
+    auto &timings = tuning_result.timings;
+    worker.Send(sequence, WorkerResult{tuning_result.time, tuning_result.threads,
+                                       tuning_result.status, tuning_result.failure_reason,
+                                       tuning_result.timed_out, tuning_result.peak_memory,
+                                       {timings.kernel, timings.submitted, timings.queued,
+                                        timings.wall_clock},
+                                       tuning_result.energy, tuning_result.power,
+                                       tuning_result.compile_time, tuning_result.local_memory});
+  }
+  worker_finished_ = true;
+}
+
+// A process is a worker if it was started with the worker address set in its environment
+bool TunerImpl::IsDistributedWorker() const {
+  return getenv(kWorkerAddressVariable) != nullptr;
+}
+
+// =================================================================================================
+
 // Compiles the kernel and checks for error messages, sets all output buffers to zero,
 // launches the kernel, and collects the timing information.
 TunerImpl::TunerResult TunerImpl::RunKernel(const std::string &source, const KernelInfo &kernel,
                                             const size_t configuration_id,
                                             const size_t num_configurations) {
+  TRACE_SPAN("tuner", "RunKernel " + kernel.name());
 
   // In case of an exception, skip this run
+  auto &memory_usage = *context_.memory_usage();
   try {
 
+    // Clears all previous copies of output buffer(s)
+    for (auto &mem_info: arguments_output_copy_) { FreeBuffer(mem_info.buffer); }
+    arguments_output_copy_.clear();
+    memory_usage.ResetPeak();
+
+    // Keeps the host memory of the outputs of a previous streamed run of this kernel for re-use
+    streamed_outputs_.resize(kernel.arguments_output_streamed().size());
+
+    // Admission control: rejects the configuration if its output copies (and streamed chunks) do
+    // not fit in the device memory budget next to the buffers already allocated
+    auto footprint = RunFootprint(kernel);
+    auto budget = static_cast<size_t>(device_.MemorySize());
+    if (memory_budget_ != 0) { budget = std::min(budget, memory_budget_); }
+    if (memory_usage.Current() + footprint > budget) {
+      throw std::runtime_error("Insufficient device memory: needs " + std::to_string(footprint) +
+                               " bytes with " + std::to_string(memory_usage.Current()) + " of " +
+                               std::to_string(budget) + " bytes in use");
+    }
+
     // Compiles the kernel and prints the compiler errors/warnings
     #ifdef VERBOSE
       fprintf(stdout, "%s Starting compilation\n", kMessageVerbose.c_str());
     #endif
     auto program = Program(context_, source);
     auto options = std::vector<std::string>{};
-    auto build_status = program.Build(device_, options);
+    builds_.WaitForSlot();
+    auto compile_start = std::chrono::steady_clock::now();
+    auto build_status = BuildProgram(program, options);
+    auto compile_elapsed = std::chrono::steady_clock::now() - compile_start;
+    auto compile_time = std::chrono::duration<float, std::milli>(compile_elapsed).count();
     if (build_status == BuildStatus::kError) {
       auto message = program.GetBuildInfo(device_);
       fprintf(stdout, "device compiler error/warning: %s\n", message.c_str());
@@ -338,16 +594,13 @@ TunerImpl::TunerResult TunerImpl::RunKernel(const std::string &source, const Ker
     #ifdef VERBOSE
       fprintf(stdout, "%s Finished compilation\n", kMessageVerbose.c_str());
     #endif
+    auto local_memory = static_cast<size_t>(Kernel(program, kernel.name()).LocalMemUsage(device_));
 
-    // Clears all previous copies of output buffer(s)
-    for (auto &mem_info: arguments_output_copy_) {
-      #ifdef USE_OPENCL
-        CheckError(clReleaseMemObject(mem_info.buffer));
-      #else
-        CheckError(cuMemFree(mem_info.buffer));
-      #endif
-    }
-    arguments_output_copy_.clear();
+    // The whole run from here (output copies, argument setup, transfers, launches, and
+    // synchronization) is recorded as a span of the trace
+    #ifdef CLTUNE_TRACE
+      auto run_trace_start = Trace::Now();
+    #endif
 
     // Creates a copy of the output buffer(s)
     #ifdef VERBOSE
@@ -371,9 +624,52 @@ TunerImpl::TunerResult TunerImpl::RunKernel(const std::string &source, const Ker
     auto global = kernel.global();
     auto local = kernel.local();
 
+    // The deadline for all runs of this configuration
+    auto run_limit_ms = RunTimeLimit();
+    auto run_start = std::chrono::steady_clock::now();
+
+    // Streamed kernels are run separately, including the transfers of their arguments
+    auto timings = RunTimings{0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0};
+    auto counters = HardwareCounters{0, 0, 0, 0, 0};
+
+    // Measures the energy of the launches between the calls of 'start_energy' and 'stop_energy':
+    // the energy per launch is summed over the iterations, the power is averaged over all launches
+    auto energy = 0.0f;
+    auto energy_total = 0.0;
+    auto energy_seconds = 0.0;
+    auto energy_start = 0.0;
+    auto energy_start_time = std::chrono::steady_clock::now();
+    auto start_energy = [&]() {
+      energy_start = energy_meter_->Read();
+      energy_start_time = std::chrono::steady_clock::now();
+    };
+    auto stop_energy = [&](const size_t num_launches) {
+      auto consumed = energy_meter_->Read() - energy_start;
+      auto elapsed = std::chrono::steady_clock::now() - energy_start_time;
+      energy += static_cast<float>(consumed / static_cast<double>(num_launches));
+      energy_total += consumed;
+      energy_seconds += std::chrono::duration<double>(elapsed).count();
+    };
+
+    // The time of each run (summed over the iterations) and the optional background load
+    auto run_times = std::vector<float>(num_runs_, 0.0f);
+    auto background_load = std::unique_ptr<BackgroundLoad>();
+    if (background_threads_ > 0) { background_load.reset(new BackgroundLoad(background_threads_)); }
+
+    auto num_iterations = kernel.num_current_iterations();
+    if (kernel.IsStreamed()) {
+      if (perf_counters_) { perf_counters_->Start(); }
+      if (energy_meter_) { start_energy(); }
+      timings = RunStreamed(program, kernel, run_limit_ms, run_start);
+      run_times = std::vector<float>(1, timings.Get(timing_metric_));
+      if (energy_meter_) { stop_energy(1); }
+      if (perf_counters_) { perf_counters_->Stop(counters, 1); }
+      num_iterations = 0;
+    }
+
     // Runs the kernel specified number of iterations over different input / output sections
-    float total_elapsed_time = 0.0f;
-    for (auto iteration = size_t{ 0 }; iteration < kernel.num_current_iterations(); iteration++) {
+    for (auto iteration = size_t{ 0 }; iteration < num_iterations; iteration++) {
+      TRACE_SPAN("tuner", "Launch");
       // Sets the kernel and its arguments
       #ifdef VERBOSE
         fprintf(stdout, "%s Setting kernel arguments\n", kMessageVerbose.c_str());
@@ -442,25 +738,82 @@ TunerImpl::TunerResult TunerImpl::RunKernel(const std::string &source, const Ker
                 kernel.name().c_str(), iteration + 1, kernel.num_current_iterations());
       }
       auto events = std::vector<Event>(num_runs_);
+      auto host_times = std::vector<float>(num_runs_);
+      if (perf_counters_) { perf_counters_->Start(); }
+      if (energy_meter_) { start_energy(); }
+      #ifdef CLTUNE_TRACE
+        auto launch_times = std::vector<double>(num_runs_);
+      #endif
       for (auto t = size_t{ 0 }; t<num_runs_; ++t) {
         #ifdef VERBOSE
           fprintf(stdout, "%s Launching kernel (%zu out of %zu for averaging)\n",
                   kMessageVerbose.c_str(), t + 1, num_runs_);
         #endif
+        #ifdef CLTUNE_TRACE
+          launch_times[t] = Trace::Now();
+        #endif
+        auto host_start = std::chrono::steady_clock::now();
         tune_kernel.Launch(queue_, global, local, events[t].pointer());
+
+        // Polls for completion when there is a limit: the kernel itself cannot be aborted, but the
+        // tuner stops waiting for it
+        if (run_limit_ms > 0.0f) {
+          queue_.Flush();
+          while (!events[t].IsCompleted()) {
+            auto elapsed = std::chrono::steady_clock::now() - run_start;
+            if (std::chrono::duration<float, std::milli>(elapsed).count() > run_limit_ms) {
+              throw TimeoutError("timed out", run_limit_ms);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+          }
+        }
         queue_.Finish(events[t]);
+        auto host_elapsed = std::chrono::steady_clock::now() - host_start;
+        host_times[t] = std::chrono::duration<float, std::milli>(host_elapsed).count();
       }
       queue_.Finish();
-
-      // Collects the timing information
-      auto elapsed_time = std::numeric_limits<float>::max();
+      if (energy_meter_) { stop_energy(num_runs_); }
+      if (perf_counters_) { perf_counters_->Stop(counters, num_runs_); }
+
+      // Collects the timing information: the fastest run by each of the device metrics and by the
+      // host time from the launch to its completion (wall-clock), and the timestamps of the first
+      // launch and the end of the last. The time of each run is taken by the timing metric.
+      auto fastest = std::vector<float>(3, std::numeric_limits<float>::max());
+      auto metric_index = (timing_metric_ == TimingMetric::kQueued) ? size_t{0} :
+                          (timing_metric_ == TimingMetric::kSubmitted) ? size_t{1} :
+                          (timing_metric_ == TimingMetric::kKernel) ? size_t{2} : size_t{3};
       for (auto t = size_t{ 0 }; t<num_runs_; ++t) {
-        auto this_elapsed_time = events[t].GetElapsedTime();
-        elapsed_time = std::min(elapsed_time, this_elapsed_time);
+        auto timestamps = events[t].GetTimestamps();
+        for (auto m = size_t{0}; m < fastest.size(); ++m) {
+          auto elapsed = (timestamps[3] > timestamps[m]) ? timestamps[3] - timestamps[m] : 0;
+          fastest[m] = std::min(fastest[m], static_cast<float>(elapsed) * 1.0e-6f);
+          if (m == metric_index) { run_times[t] += static_cast<float>(elapsed) * 1.0e-6f; }
+        }
+        if (timing_metric_ == TimingMetric::kWallClock) { run_times[t] += host_times[t]; }
+        if (iteration == 0 && t == 0) {
+          timings.queued_ns = timestamps[0];
+          timings.submitted_ns = timestamps[1];
+          timings.start_ns = timestamps[2];
+        }
+        timings.end_ns = timestamps[3];
+        #ifdef CLTUNE_TRACE
+          Trace::AddDeviceEvent(kernel.name(), launch_times[t], timestamps);
+        #endif
       }
-
-      total_elapsed_time += elapsed_time;
+      timings.queued += fastest[0];
+      timings.submitted += fastest[1];
+      timings.kernel += fastest[2];
+      timings.wall_clock += *std::min_element(host_times.begin(), host_times.end());
+    }
+    #ifdef CLTUNE_TRACE
+      Trace::AddSpan("tuner", "Run " + kernel.name(), run_trace_start, Trace::Now());
+    #endif
+    background_load.reset();
+    auto total_elapsed_time = timings.Get(timing_metric_);
+    if (run_statistic_ != RunStatistic::kMinimum) {
+      total_elapsed_time = RunStatisticOf(run_times);
     }
+    auto power = (energy_seconds > 0.0) ? static_cast<float>(energy_total / energy_seconds) : 0.0f;
 
     // Prints diagnostic information
     fprintf(stdout, "%s Completed %s (%.1lf ms) - %zu out of %zu\n",
@@ -470,7 +823,20 @@ TunerImpl::TunerResult TunerImpl::RunKernel(const std::string &source, const Ker
     // Computes the result of the tuning
     auto local_threads = size_t{ 1 };
     for (auto &item : local) { local_threads *= item; }
-    TunerResult result = {kernel.name(), total_elapsed_time, local_threads, false, {}};
+    TunerResult result = {kernel.name(), total_elapsed_time, local_threads, false, {}, "", false,
+                          VerificationConfidence(kernel), memory_usage.Peak(), timings, counters,
+                          energy, power, compile_time, local_memory, run_times, drift_,
+                          false};
+    return result;
+  }
+
+  // The time limit was exceeded: returns the limit as the (lower bound on the) time
+  catch(TimeoutError& e) {
+    fprintf(stdout, "%s Kernel %s %s\n", kMessageFailure.c_str(), kernel.name().c_str(), e.what());
+    TunerResult result = {kernel.name(), e.limit_ms(), 0, false, {}, e.what(), true, 0.0,
+                          memory_usage.Peak(), RunTimings{0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0},
+                          HardwareCounters{0, 0, 0, 0, 0}, 0.0f, 0.0f, 0.0f, 0, {}, drift_,
+                          false};
     return result;
   }
 
@@ -478,13 +844,411 @@ TunerImpl::TunerResult TunerImpl::RunKernel(const std::string &source, const Ker
   catch(std::exception& e) {
     fprintf(stdout, "%s Kernel %s failed\n", kMessageFailure.c_str(), kernel.name().c_str());
     fprintf(stdout, "%s   caught exception: %s\n", kMessageFailure.c_str(), e.what());
-    TunerResult result = {kernel.name(), std::numeric_limits<float>::max(), 0, false, {}};
+    TunerResult result = {kernel.name(), std::numeric_limits<float>::max(), 0, false, {},
+                          e.what(), false, 0.0, memory_usage.Peak(),
+                          RunTimings{0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0},
+                          HardwareCounters{0, 0, 0, 0, 0}, 0.0f, 0.0f, 0.0f, 0, {}, drift_,
+                          false};
     return result;
   }
 }
 
 // =================================================================================================
 
+// Streaming: the host-resident arguments are split into equal chunks, which are processed by a
+// number of slots in turn. Each slot has its own queue, kernel, and device buffers. The upload of a
+// chunk, the kernel, and the download of its outputs are enqueued in order on the queue of the
+// slot, such that the transfers of one slot overlap with the computations of the others. A slot is
+// re-used once its previous chunk is downloaded. The kernel time is that of the whole pipeline,
+// measured on the host, since kernels and transfers overlap. The other device metrics span from the
+// first chunk to the end of the last.
+RunTimings TunerImpl::RunStreamed(const Program &program, const KernelInfo &kernel,
+                                  const float run_limit_ms,
+                                  const std::chrono::steady_clock::time_point run_start) {
+  TRACE_SPAN("tuner", "RunStreamed");
+  auto &inputs = kernel.arguments_input_streamed();
+  auto &outputs = kernel.arguments_output_streamed();
+  auto num_chunks = kernel.num_current_chunks();
+  auto num_slots = std::min(kernel.num_current_in_flight(), num_chunks);
+  if (num_chunks == 0 || num_slots == 0) {
+    throw std::runtime_error("Invalid number of chunks or chunks in flight");
+  }
+  if (kernel.num_current_iterations() != 1 || !kernel.arguments_output().empty()) {
+    throw std::runtime_error("Streamed kernels support neither iterations nor device outputs");
+  }
+  for (auto &argument : inputs) {
+    if (argument.size % num_chunks != 0) {
+      throw std::runtime_error("Streamed argument size is not a multiple of the number of chunks");
+    }
+  }
+  for (auto &argument : outputs) {
+    if (argument.size % num_chunks != 0) {
+      throw std::runtime_error("Streamed argument size is not a multiple of the number of chunks");
+    }
+  }
+  auto chunk_bytes = [num_chunks](const KernelInfo::StreamedArgument &argument) {
+    return argument.data.size() / num_chunks;
+  };
+
+  // Prepares the host memory for the outputs: these are verified as a whole after the run
+  for (auto o = size_t{0}; o < outputs.size(); ++o) {
+    streamed_outputs_[o].type = outputs[o].type;
+    streamed_outputs_[o].sample = OutputSample{{0}, outputs[o].size};
+    streamed_outputs_[o].data.resize(outputs[o].data.size());
+  }
+
+  // Sets up the slots: the chunk buffers are the first arguments, the others are the same for all
+  while (stream_queues_.size() < num_slots) { stream_queues_.push_back(Queue(context_, device_)); }
+  auto slot_kernels = std::vector<Kernel>();
+  auto slot_buffers = std::vector<std::vector<Buffer<unsigned char>>>(num_slots);
+  for (auto s = size_t{0}; s < num_slots; ++s) {
+    slot_kernels.push_back(Kernel(program, kernel.name()));
+    auto &slot_kernel = slot_kernels.back();
+    for (auto &argument : inputs) {
+      slot_buffers[s].push_back(Buffer<unsigned char>(context_, BufferAccess::kReadWrite,
+                                                      chunk_bytes(argument)));
+      slot_kernel.SetArgument(argument.index, slot_buffers[s].back()());
+    }
+    for (auto &argument : outputs) {
+      slot_buffers[s].push_back(Buffer<unsigned char>(context_, BufferAccess::kReadWrite,
+                                                      chunk_bytes(argument)));
+      slot_kernel.SetArgument(argument.index, slot_buffers[s].back()());
+    }
+    for (auto &i : kernel.arguments_input()) { slot_kernel.SetArgument(i.index, i.buffer); }
+    for (auto &i : kernel.arguments_int()) { slot_kernel.SetArgument(i.first, i.second); }
+    for (auto &i : kernel.arguments_size_t()) { slot_kernel.SetArgument(i.first, i.second); }
+    for (auto &i : kernel.arguments_float()) { slot_kernel.SetArgument(i.first, i.second); }
+    for (auto &i : kernel.arguments_double()) { slot_kernel.SetArgument(i.first, i.second); }
+    for (auto &i : kernel.arguments_float2()) { slot_kernel.SetArgument(i.first, i.second); }
+    for (auto &i : kernel.arguments_double2()) { slot_kernel.SetArgument(i.first, i.second); }
+  }
+
+  // Verifies the local memory usage of the kernel
+  auto local_mem_usage = slot_kernels.front().LocalMemUsage(device_);
+  if (!device_.IsLocalMemoryValid(local_mem_usage)) {
+    throw std::runtime_error("Using too much local memory");
+  }
+
+  // Waits until a chunk is processed, polling for completion of its kernel when there is a limit
+  auto events = std::vector<Event>(num_chunks);
+  auto wait_for_chunk = [&](const size_t c) {
+    auto &queue = stream_queues_[c % num_slots];
+    if (run_limit_ms > 0.0f) {
+      while (!events[c].IsCompleted()) {
+        auto elapsed = std::chrono::steady_clock::now() - run_start;
+        if (std::chrono::duration<float, std::milli>(elapsed).count() > run_limit_ms) {
+          throw TimeoutError("timed out", run_limit_ms);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+    queue.Finish();
+  };
+
+  // Runs all chunks (this is the timed part)
+  fprintf(stdout, "%s Running %s (%zu chunks, %zu in flight)\n", kMessageRun.c_str(),
+          kernel.name().c_str(), num_chunks, num_slots);
+  queue_.Finish();
+  auto global = kernel.global();
+  auto local = kernel.local();
+  #ifdef CLTUNE_TRACE
+    auto launch_times = std::vector<double>(num_chunks);
+  #endif
+  auto start_time = std::chrono::steady_clock::now();
+  for (auto c = size_t{0}; c < num_chunks; ++c) {
+    auto s = c % num_slots;
+    auto &queue = stream_queues_[s];
+    if (c >= num_slots) { wait_for_chunk(c - num_slots); }
+    auto b = size_t{0};
+    for (auto &argument : inputs) {
+      auto bytes = chunk_bytes(argument);
+      slot_buffers[s][b++].WriteAsync(queue, bytes, argument.data.data() + c * bytes);
+    }
+    for (auto &argument : outputs) {
+      auto bytes = chunk_bytes(argument);
+      slot_buffers[s][b++].WriteAsync(queue, bytes, argument.data.data() + c * bytes);
+    }
+    #ifdef CLTUNE_TRACE
+      launch_times[c] = Trace::Now();
+    #endif
+    slot_kernels[s].Launch(queue, global, local, events[c].pointer());
+    b = inputs.size();
+    for (auto o = size_t{0}; o < outputs.size(); ++o) {
+      auto bytes = chunk_bytes(outputs[o]);
+      slot_buffers[s][b++].ReadAsync(queue, bytes, streamed_outputs_[o].data.data() + c * bytes);
+    }
+    queue.Flush();
+  }
+  for (auto c = num_chunks - num_slots; c < num_chunks; ++c) { wait_for_chunk(c); }
+  auto elapsed_time = std::chrono::steady_clock::now() - start_time;
+
+  // Collects the timing information
+  auto first = events.front().GetTimestamps();
+  auto end_ns = first[3];
+  for (auto c = size_t{0}; c < num_chunks; ++c) {
+    auto timestamps = events[c].GetTimestamps();
+    end_ns = std::max(end_ns, timestamps[3]);
+    #ifdef CLTUNE_TRACE
+      Trace::AddDeviceEvent(kernel.name(), launch_times[c], timestamps);
+    #endif
+  }
+  auto since = [end_ns](const unsigned long long timestamp) {
+    return (end_ns > timestamp) ? static_cast<float>(end_ns - timestamp) * 1.0e-6f : 0.0f;
+  };
+  auto pipeline_time = std::chrono::duration<float, std::milli>(elapsed_time).count();
+  return RunTimings{pipeline_time, since(first[1]), since(first[0]), pipeline_time, first[0],
+                    first[1], first[2], end_ns};
+}
+
+// =================================================================================================
+
+// Runs the compilation on a separate thread when there is a time limit. An abandoned compilation
+// finishes in the background: the task holds its own references to the program and its status.
+BuildStatus TunerImpl::BuildProgram(Program &program, std::vector<std::string> &options) {
+  TRACE_SPAN("tuner", "BuildProgram");
+  if (compile_timeout_ms_ <= 0.0f) { return program.Build(device_, options); }
+  auto device = device_;
+  auto build_status = std::make_shared<BuildStatus>(BuildStatus::kError);
+  auto build = [program, device, options, build_status]() mutable {
+    *build_status = program.Build(device, options);
+  };
+  if (!builds_.Run(build, compile_timeout_ms_)) {
+    throw TimeoutError("compilation timed out", compile_timeout_ms_);
+  }
+  return *build_status;
+}
+
+// The run-time limit is the fixed limit, or a multiple of the best time so far if that is tighter
+float TunerImpl::RunTimeLimit() const {
+  auto limit = run_timeout_ms_;
+  if (relative_timeout_ > 0.0f && best_time_ != std::numeric_limits<float>::max()) {
+    auto relative_limit = relative_timeout_ * best_time_;
+    limit = (limit > 0.0f) ? std::min(limit, relative_limit) : relative_limit;
+  }
+  return limit;
+}
+
+// Timed-out results are known to be at least as slow as the limit: they are reported as a large but
+// finite time, such that the search strategies can still rank them (unlike plain failures). Their
+// other objectives are unknown, so for other objectives they are treated as failures, as are the
+// results which violate a constraint. Otherwise, this is the weighted sum of the objectives.
+float TunerImpl::SearcherFeedback(const TunerResult &result) const {
+  auto &first = objective_weights_.front();
+  auto time_only = (objective_weights_.size() == 1 && first.first == Objective::kTime);
+  if (result.timed_out && time_only) { return kTimeoutPenalty * first.second * result.time; }
+  if (result.timed_out || result.time == std::numeric_limits<float>::max() ||
+      !ConstraintViolation(result).empty()) {
+    return std::numeric_limits<float>::max();
+  }
+  auto feedback = 0.0;
+  for (auto &weight: objective_weights_) {
+    feedback += weight.second * ObjectiveValue(result, weight.first);
+  }
+  return static_cast<float>(feedback);
+}
+
+// =================================================================================================
+
+// Runs the baseline configuration of the drift sentinel. Its result is not stored.
+float TunerImpl::RunBaseline(const size_t id, const KernelInfo::Configuration &baseline) {
+  TRACE_SPAN("tuner", "RunBaseline");
+  auto &kernel = kernels_.at(id);
+  kernel.ComputeRanges(baseline);
+  kernel.SetNumCurrentIterations(baseline);
+  kernel.SetNumCurrentChunks(baseline);
+  auto result = RunKernel(GetConfiguredKernelSource(id, baseline), kernel, 0, 1);
+  if (result.timed_out) { return std::numeric_limits<float>::max(); }
+  return result.time;
+}
+
+// Re-runs the baseline and compares it to its initial time. In case of drift beyond the tolerance,
+// the following results are normalized by the drift, or the tuner pauses until the baseline has
+// recovered (or until it gives up) and re-measures the results since the previous check. The
+// searcher keeps the feedback of the original measurements.
+void TunerImpl::CheckDrift(const size_t id, DriftSentinel &sentinel, const size_t num_explored,
+                           const size_t first_affected) {
+  TRACE_SPAN("tuner", "CheckDrift");
+  while (!pending_verifications_.empty()) { FinishVerification(); }
+  auto &kernel = kernels_.at(id);
+  auto time = RunBaseline(id, sentinel.baseline);
+  if (time == std::numeric_limits<float>::max()) {
+    fprintf(stdout, "%s Baseline of %s failed, skipping the drift check\n",
+            kMessageWarning.c_str(), kernel.name().c_str());
+    return;
+  }
+  auto drifted = [&sentinel](const float baseline_time) {
+    return std::fabs(baseline_time / sentinel.baseline_time - 1.0f) > sentinel.tolerance;
+  };
+  if (!drifted(time)) {
+    drift_ = 1.0f;
+    return;
+  }
+  drift_ = time / sentinel.baseline_time;
+  fprintf(stdout, "%s Drift of %s: baseline at %.2lfx its initial time after %zu configurations\n",
+          kMessageWarning.c_str(), kernel.name().c_str(), drift_, num_explored);
+  auto event = DriftEvent{kernel.name(), num_explored, drift_, 0};
+
+  // Waits for the baseline to recover and re-measures the affected results
+  if (sentinel.action == DriftAction::kRemeasure) {
+    for (auto pause = size_t{0}; pause < kMaxDriftPauses && drifted(time); ++pause) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(kDriftPauseMs));
+      auto retry = RunBaseline(id, sentinel.baseline);
+      if (retry != std::numeric_limits<float>::max()) { time = retry; }
+    }
+    drift_ = drifted(time) ? time / sentinel.baseline_time : 1.0f;
+    fprintf(stdout, "%s Re-measuring %zu configurations of %s (baseline at %.2lfx)\n",
+            kMessageInfo.c_str(), tuning_results_.size() - first_affected, kernel.name().c_str(),
+            time / sentinel.baseline_time);
+    for (auto r = first_affected; r < tuning_results_.size(); ++r) {
+      auto &result = tuning_results_[r];
+      if (!result.status && !result.unverified) { continue; }
+      kernel.ComputeRanges(result.configuration);
+      kernel.SetNumCurrentIterations(result.configuration);
+      kernel.SetNumCurrentChunks(result.configuration);
+      auto remeasured = RunKernel(GetConfiguredKernelSource(id, result.configuration), kernel,
+                                  r - first_affected, tuning_results_.size() - first_affected);
+      auto failed = (remeasured.time == std::numeric_limits<float>::max());
+      if (failed || remeasured.timed_out) { continue; }
+      result.time = remeasured.time;
+      result.timings = remeasured.timings;
+      result.counters = remeasured.counters;
+      result.energy = remeasured.energy;
+      result.power = remeasured.power;
+      result.run_times = remeasured.run_times;
+      result.drift = remeasured.drift;
+      if (result.status || result.unverified) { best_time_ = std::min(best_time_, result.time); }
+      event.num_remeasured++;
+    }
+  }
+  drift_events_.push_back(event);
+}
+
+// =================================================================================================
+
+// Percentiles are computed by the nearest-rank method: the smallest time such that at least the
+// given percentage of the runs is at most that time. The standard deviation is of the runs itself.
+float TunerImpl::RunStatisticOf(std::vector<float> run_times) const {
+  if (run_times.empty()) { return 0.0f; }
+  std::sort(run_times.begin(), run_times.end());
+  auto num_runs = static_cast<double>(run_times.size());
+  auto mean = 0.0;
+  for (auto &run_time: run_times) { mean += run_time / num_runs; }
+  auto variance = 0.0;
+  for (auto &run_time: run_times) { variance += (run_time - mean) * (run_time - mean) / num_runs; }
+  switch (run_statistic_) {
+    case RunStatistic::kMean: return static_cast<float>(mean);
+    case RunStatistic::kMeanPlusStdDev:
+      return static_cast<float>(mean + run_statistic_parameter_ * std::sqrt(variance));
+    case RunStatistic::kMaximum: return run_times.back();
+    case RunStatistic::kPercentile: {
+      auto rank = static_cast<size_t>(std::ceil(run_statistic_parameter_ / 100.0 * num_runs));
+      return run_times[std::min(std::max(rank, size_t{1}), run_times.size()) - 1];
+    }
+    default: return run_times.front();
+  }
+}
+
+// =================================================================================================
+
+double TunerImpl::ObjectiveValue(const TunerResult &result, const Objective objective) const {
+  switch (objective) {
+    case Objective::kEnergy: return result.energy;
+    case Objective::kEnergyDelay: return static_cast<double>(result.energy) * result.time;
+    case Objective::kCompileTime: return result.compile_time;
+    case Objective::kLocalMemory: return static_cast<double>(result.local_memory);
+    case Objective::kDeviceMemory: return static_cast<double>(result.peak_memory);
+    default: return result.time;
+  }
+}
+
+std::string TunerImpl::ConstraintViolation(const TunerResult &result) const {
+  const auto kNames = std::vector<std::string>{"time", "energy", "energy-delay product",
+                                               "compilation time", "local memory",
+                                               "device memory"};
+  for (auto &constraint: objective_constraints_) {
+    auto value = ObjectiveValue(result, constraint.first);
+    if (value > constraint.second) {
+      auto name = kNames[static_cast<size_t>(constraint.first)];
+      return "exceeds the " + name + " constraint: " + std::to_string(value) + " > " +
+             std::to_string(constraint.second);
+    }
+  }
+  return std::string{};
+}
+
+std::vector<double> TunerImpl::ParetoObjectives(const TunerResult &result) const {
+  auto objectives = std::vector<double>();
+  if (result.timed_out || result.time == std::numeric_limits<float>::max() ||
+      !ConstraintViolation(result).empty()) {
+    return objectives;
+  }
+  for (auto &objective: pareto_objectives_) {
+    objectives.push_back(ObjectiveValue(result, objective));
+  }
+  return objectives;
+}
+
+// Computes the front of each kernel separately
+std::vector<bool> TunerImpl::ParetoOptimal() const {
+  auto optimal = std::vector<bool>(tuning_results_.size(), false);
+  auto kernel_names = std::vector<std::string>();
+  for (auto &tuning_result: tuning_results_) {
+    auto &name = tuning_result.kernel_name;
+    if (std::find(kernel_names.begin(), kernel_names.end(), name) == kernel_names.end()) {
+      kernel_names.push_back(name);
+    }
+  }
+  for (auto &kernel_name: kernel_names) {
+    auto indices = std::vector<size_t>();
+    auto points = std::vector<std::vector<double>>();
+    for (auto r = size_t{0}; r < tuning_results_.size(); ++r) {
+      if (tuning_results_[r].kernel_name != kernel_name) { continue; }
+      indices.push_back(r);
+      auto correct = tuning_results_[r].status;
+      points.push_back((correct) ? ParetoObjectives(tuning_results_[r]) : std::vector<double>());
+    }
+    for (auto &p: Searcher::ParetoFront(points)) { optimal[indices[p]] = true; }
+  }
+  return optimal;
+}
+
+// =================================================================================================
+
+// Prints a failure or warning for a result and stores it. Failed and timed-out results get a status
+// of false, such that they are never selected as the best result.
+void TunerImpl::StoreResult(TunerResult tuning_result) {
+  TRACE_SPAN("tuner", "StoreResult");
+  if (tuning_result.timed_out) {
+    PrintResult(stdout, tuning_result, kMessageFailure);
+    tuning_result.status = false;
+  }
+  else if (tuning_result.time == std::numeric_limits<float>::max()) {
+    tuning_result.time = 0.0;
+    PrintResult(stdout, tuning_result, kMessageFailure);
+    tuning_result.time = std::numeric_limits<float>::max();
+    tuning_result.status = false;
+  }
+  else if (!ConstraintViolation(tuning_result).empty()) {
+    tuning_result.failure_reason = ConstraintViolation(tuning_result);
+    fprintf(stdout, "%s Kernel %s rejected: %s\n", kMessageWarning.c_str(),
+            tuning_result.kernel_name.c_str(), tuning_result.failure_reason.c_str());
+    tuning_result.status = false;
+  }
+  else if (tuning_result.unverified) {
+    PrintResult(stdout, tuning_result, kMessageInfo);
+    best_time_ = std::min(best_time_, tuning_result.time);
+  }
+  else if (!tuning_result.status) {
+    PrintResult(stdout, tuning_result, kMessageWarning);
+  }
+  else {
+    best_time_ = std::min(best_time_, tuning_result.time);
+  }
+  tuning_results_.push_back(tuning_result);
+}
+
+// =================================================================================================
+
 // Converts TunerResult object to PublicTunerResult.
 PublicTunerResult TunerImpl::ConvertTuningResultToPublic(const TunerImpl::TunerResult &result) {
   PublicTunerResult public_result;
@@ -492,6 +1256,17 @@ PublicTunerResult TunerImpl::ConvertTuningResultToPublic(const TunerImpl::TunerR
   public_result.time = result.time;
   public_result.threads = result.threads;
   public_result.status = result.status;
+  public_result.failure_reason = result.failure_reason;
+  public_result.confidence = result.confidence;
+  public_result.peak_memory = result.peak_memory;
+  public_result.timings = result.timings;
+  public_result.counters = result.counters;
+  public_result.energy = result.energy;
+  public_result.power = result.power;
+  public_result.compile_time = result.compile_time;
+  public_result.local_memory = result.local_memory;
+  public_result.run_times = result.run_times;
+  public_result.drift = result.drift;
 
   for (auto &parameter : result.configuration) {
     public_result.parameter_values.push_back(std::make_pair(parameter.name, parameter.value));
@@ -504,6 +1279,7 @@ PublicTunerResult TunerImpl::ConvertTuningResultToPublic(const TunerImpl::TunerR
 
 // Returns searcher for specified kernel.
 std::unique_ptr<Searcher> TunerImpl::GetSearcher(const size_t id) {
+  TRACE_SPAN("searcher", "GetSearcher");
   KernelInfo& kernel = kernels_.at(id);
   kernel.SetConfigurations();
 
@@ -527,6 +1303,9 @@ std::unique_ptr<Searcher> TunerImpl::GetSearcher(const size_t id) {
     break;
   }
 
+  // Seeds the search with the starting points of earlier runs, if any
+  auto warm_start = warm_starts_.find(id);
+  if (warm_start != warm_starts_.end()) { searcher->SetStartingPoints(warm_start->second); }
   return searcher;
 }
 
@@ -554,6 +1333,10 @@ void TunerImpl::InitializeSearcher(const size_t id) {
                                             kernel.search_args().at(3), kernel.search_args().at(4) });
     break;
   }
+  auto warm_start = warm_starts_.find(id);
+  if (warm_start != warm_starts_.end()) {
+    kernel_searchers_.at(id)->SetStartingPoints(warm_start->second);
+  }
 }
 
 // =================================================================================================
@@ -606,15 +1389,258 @@ std::string TunerImpl::GetConfiguredKernelSource(const size_t id,
 
 // =================================================================================================
 
-// Runs reference kernel and stores its result.
+// Runs reference kernel and stores its result. The reference is not run again if its output is
+// already in the cache: either from a previous call or (with a cache directory) a previous session.
+// Failed reference runs are not cached.
 void TunerImpl::RunReferenceKernel() {
-  if (has_reference_) {
+  TRACE_SPAN("tuner", "RunReferenceKernel");
+  if (has_reference_ && reference_function_) {
+    RunReferenceFunction();
+  }
+  else if (has_reference_) {
+    auto key = ReferenceKey();
+    auto cached_outputs = reference_cache_.Find(key);
+    if (cached_outputs) {
+      PrintHeader("Using cached output of reference " + reference_kernel_->name());
+      SetReferenceOutputs(cached_outputs);
+      return;
+    }
     PrintHeader("Testing reference " + reference_kernel_->name());
-    RunKernel(reference_kernel_->source(), *reference_kernel_, 0, 1);
+    auto result = RunKernel(reference_kernel_->source(), *reference_kernel_, 0, 1);
     StoreReferenceOutput();
+    if (result.time != std::numeric_limits<float>::max() && !result.timed_out) {
+      reference_cache_.Store(key, reference_outputs_.get());
+    }
+  }
+}
+
+// Starts the host reference function on a separate thread. Its outputs are initialized with the
+// initial contents of the output arguments of the first kernel, which are downloaded first. The
+// output of a host function is not cached: it cannot be identified by a key.
+void TunerImpl::RunReferenceFunction() {
+  if (kernels_.empty()) { throw std::runtime_error("Reference function requires a kernel to tune"); }
+  PrintHeader("Starting the host reference function");
+  auto outputs = std::make_shared<ReferenceOutputs>();
+  for (auto &output_buffer: kernels_.front().arguments_output()) {
+    switch (output_buffer.type) {
+      case MemType::kShort: DownloadReference<short>(output_buffer, *outputs); break;
+      case MemType::kInt: DownloadReference<int>(output_buffer, *outputs); break;
+      case MemType::kSizeT: DownloadReference<size_t>(output_buffer, *outputs); break;
+      case MemType::kHalf: DownloadReference<half>(output_buffer, *outputs); break;
+      case MemType::kFloat: DownloadReference<float>(output_buffer, *outputs); break;
+      case MemType::kDouble: DownloadReference<double>(output_buffer, *outputs); break;
+      case MemType::kFloat2: DownloadReference<float2>(output_buffer, *outputs); break;
+      case MemType::kDouble2: DownloadReference<double2>(output_buffer, *outputs); break;
+      default: throw std::runtime_error("Unsupported reference output data-type");
+    }
+  }
+  for (auto &output_argument: kernels_.front().arguments_output_streamed()) {
+    auto data = outputs->AddOutput(output_argument.data.size());
+    std::memcpy(data, output_argument.data.data(), output_argument.data.size());
+  }
+  auto function = reference_function_;
+  auto reference = std::async(std::launch::async, [outputs, function]() {
+    auto host_buffers = std::vector<void*>();
+    for (auto i = size_t{0}; i < outputs->NumOutputs(); ++i) {
+      host_buffers.push_back(outputs->Data(i));
+    }
+    function(host_buffers);
+    return std::shared_ptr<const ReferenceOutputs>(outputs);
+  });
+  reference_outputs_ = reference.share();
+}
+
+// Sets reference outputs which are available right away
+void TunerImpl::SetReferenceOutputs(const std::shared_ptr<const ReferenceOutputs> &outputs) {
+  auto reference = std::promise<std::shared_ptr<const ReferenceOutputs>>();
+  reference.set_value(outputs);
+  reference_outputs_ = reference.get_future().share();
+}
+
+// The cache key consists of the name and (configured) source of the reference kernel, its thread-
+// sizes, and the descriptions of its arguments
+std::string TunerImpl::ReferenceKey() const {
+  auto key = reference_kernel_->name() + "\n" + reference_kernel_->source() + "\n";
+  for (auto &global: reference_kernel_->global()) { key += std::to_string(global) + " "; }
+  key += "/ ";
+  for (auto &local: reference_kernel_->local()) { key += std::to_string(local) + " "; }
+  return key + "\n" + reference_arguments_;
+}
+
+// Describes an argument of the reference kernel by its kind, type, size (in bytes), and a hash of
+// its contents
+void TunerImpl::AddReferenceArgumentKey(const std::string &kind, const MemType type,
+                                        const void* data, const size_t size) {
+  reference_arguments_ += kind + " " + std::to_string(static_cast<int>(type)) + " " +
+                          std::to_string(size) + " " + std::to_string(HashBytes(data, size)) + "\n";
+}
+
+// =================================================================================================
+
+// Creates the buffer of a kernel argument. Zero-copy buffers are allocated in host memory, which is
+// directly accessible by devices sharing the host memory: these are filled through a mapping.
+template <typename T>
+BufferRaw TunerImpl::UploadArgument(const std::vector<T> &source) {
+  auto device_buffer = Buffer<T>(context_, BufferAccess::kNotOwned, source.size(), buffer_memory_);
+  if (buffer_memory_ == BufferMemory::kHost) {
+    auto host_buffer = device_buffer.Map(queue_, BufferMapping::kWrite, source.size());
+    std::copy(source.begin(), source.end(), host_buffer);
+    device_buffer.Unmap(queue_, host_buffer);
+  }
+  else {
+    device_buffer.Write(queue_, source.size(), source);
+  }
+  return device_buffer();
+}
+
+// Compiles the function for various data-types
+template BufferRaw TunerImpl::UploadArgument<short>(const std::vector<short>&);
+template BufferRaw TunerImpl::UploadArgument<int>(const std::vector<int>&);
+template BufferRaw TunerImpl::UploadArgument<size_t>(const std::vector<size_t>&);
+template BufferRaw TunerImpl::UploadArgument<half>(const std::vector<half>&);
+template BufferRaw TunerImpl::UploadArgument<float>(const std::vector<float>&);
+template BufferRaw TunerImpl::UploadArgument<double>(const std::vector<double>&);
+template BufferRaw TunerImpl::UploadArgument<float2>(const std::vector<float2>&);
+template BufferRaw TunerImpl::UploadArgument<double2>(const std::vector<double2>&);
+
+// As above, but streams the data from a (range of a) memory-mapped file in chunks. While a chunk is
+// transferred, the next one is already read from disk in the background. Transferred chunks are
+// released from host memory again, such that the file never has to fit in host memory as a whole.
+template <typename T>
+BufferRaw TunerImpl::UploadFile(const MappedFile &file) {
+  if (file.size() % sizeof(T) != 0) {
+    throw std::runtime_error("File range is not a whole number of elements");
+  }
+  auto num_elements = file.size() / sizeof(T);
+  auto chunk_elements = std::max(kFileChunkSize / sizeof(T), size_t{1});
+  auto device_buffer = Buffer<T>(context_, BufferAccess::kNotOwned, num_elements, buffer_memory_);
+  file.Prefetch(0, chunk_elements * sizeof(T));
+  for (auto start = size_t{0}; start < num_elements; start += chunk_elements) {
+    auto count = std::min(chunk_elements, num_elements - start);
+    auto source = file.data() + start * sizeof(T);
+    file.Prefetch((start + count) * sizeof(T), chunk_elements * sizeof(T));
+    if (buffer_memory_ == BufferMemory::kHost) {
+      auto host_buffer = device_buffer.Map(queue_, BufferMapping::kWrite, count, start);
+      std::memcpy(host_buffer, source, count * sizeof(T));
+      device_buffer.Unmap(queue_, host_buffer);
+    }
+    else {
+      device_buffer.Write(queue_, count, reinterpret_cast<const T*>(source), start);
+    }
+    file.Release(start * sizeof(T), count * sizeof(T));
+  }
+  return device_buffer();
+}
+
+// Compiles the function for various data-types
+template BufferRaw TunerImpl::UploadFile<short>(const MappedFile&);
+template BufferRaw TunerImpl::UploadFile<int>(const MappedFile&);
+template BufferRaw TunerImpl::UploadFile<size_t>(const MappedFile&);
+template BufferRaw TunerImpl::UploadFile<half>(const MappedFile&);
+template BufferRaw TunerImpl::UploadFile<float>(const MappedFile&);
+template BufferRaw TunerImpl::UploadFile<double>(const MappedFile&);
+template BufferRaw TunerImpl::UploadFile<float2>(const MappedFile&);
+template BufferRaw TunerImpl::UploadFile<double2>(const MappedFile&);
+
+// =================================================================================================
+
+// The device memory needed for the copies of the output buffers of a kernel and for the chunk
+// buffers of each slot of a streamed kernel. A single copy larger than the maximum allocation size
+// can never be made.
+size_t TunerImpl::RunFootprint(const KernelInfo &kernel) const {
+  auto footprint = size_t{0};
+  for (auto &output : kernel.arguments_output()) {
+    auto bytes = output.size;
+    switch (output.type) {
+      case MemType::kShort: bytes *= sizeof(short); break;
+      case MemType::kInt: bytes *= sizeof(int); break;
+      case MemType::kSizeT: bytes *= sizeof(size_t); break;
+      case MemType::kHalf: bytes *= sizeof(half); break;
+      case MemType::kFloat: bytes *= sizeof(float); break;
+      case MemType::kDouble: bytes *= sizeof(double); break;
+      case MemType::kFloat2: bytes *= sizeof(float2); break;
+      case MemType::kDouble2: bytes *= sizeof(double2); break;
+      default: throw std::runtime_error("Unsupported output data-type");
+    }
+    if (bytes > static_cast<size_t>(device_.MaxAllocSize())) {
+      throw std::runtime_error("Insufficient device memory: output of " + std::to_string(bytes) +
+                               " bytes exceeds the maximum allocation size");
+    }
+    footprint += bytes;
+  }
+  if (kernel.IsStreamed()) {
+    auto num_chunks = std::max(kernel.num_current_chunks(), size_t{1});
+    auto num_slots = std::min(std::max(kernel.num_current_in_flight(), size_t{1}), num_chunks);
+    for (auto &input : kernel.arguments_input_streamed()) {
+      footprint += num_slots * (input.data.size() / num_chunks);
+    }
+    for (auto &output : kernel.arguments_output_streamed()) {
+      footprint += num_slots * (output.data.size() / num_chunks);
+    }
+  }
+  return footprint;
+}
+
+// Looks up a shared buffer by name
+std::shared_ptr<KernelInfo::SharedBuffer> TunerImpl::GetSharedBuffer(const std::string &name) const {
+  auto shared_buffer = shared_buffers_.find(name);
+  if (shared_buffer == shared_buffers_.end()) {
+    throw std::runtime_error("Unknown shared buffer: " + name);
+  }
+  return shared_buffer->second;
+}
+
+// Generates the data of a kernel argument on the device. The generator kernel is compiled the first
+// time it is used for a data-type. It runs with a bounded number of threads, each thread computing
+// multiple values.
+template <typename T>
+BufferRaw TunerImpl::GenerateArgument(const size_t size, const InputGenerator &generator) {
+  using Real = typename GeneratorTraits<T>::Real;
+  const auto kLocalSize = size_t{64};
+  const auto kMaxGroups = size_t{1024};
+
+  // Compiles the generator for this data-type
+  auto type = GetType<T>();
+  auto program = generator_programs_.find(type);
+  if (program == generator_programs_.end()) {
+    auto new_program = Program(context_, GeneratorSource(type));
+    auto options = std::vector<std::string>{};
+    if (new_program.Build(device_, options) != BuildStatus::kSuccess) {
+      auto message = new_program.GetBuildInfo(device_);
+      throw std::runtime_error("Could not compile the input generator: " + message);
+    }
+    program = generator_programs_.emplace(type, new_program).first;
   }
+
+  // Fills the buffer
+  auto device_buffer = Buffer<T>(context_, BufferAccess::kNotOwned, size, buffer_memory_);
+  auto num_values = size * GeneratorTraits<T>::kComponents;
+  auto num_groups = (num_values + kLocalSize - 1) / kLocalSize;
+  num_groups = std::max(std::min(num_groups, kMaxGroups), size_t{1});
+  auto generator_kernel = Kernel(program->second, kGeneratorKernelName);
+  generator_kernel.SetArgument(0, device_buffer());
+  generator_kernel.SetArgument(1, static_cast<uint64_t>(num_values));
+  generator_kernel.SetArgument(2, static_cast<int>(generator.distribution));
+  generator_kernel.SetArgument(3, static_cast<Real>(generator.first));
+  generator_kernel.SetArgument(4, static_cast<Real>(generator.second));
+  generator_kernel.SetArgument(5, static_cast<Real>(generator.density));
+  generator_kernel.SetArgument(6, generator.seed);
+  auto event = Event();
+  generator_kernel.Launch(queue_, {num_groups * kLocalSize}, {kLocalSize}, event.pointer());
+  queue_.Finish();
+  return device_buffer();
 }
 
+// Compiles the function for various data-types
+template BufferRaw TunerImpl::GenerateArgument<short>(const size_t, const InputGenerator&);
+template BufferRaw TunerImpl::GenerateArgument<int>(const size_t, const InputGenerator&);
+template BufferRaw TunerImpl::GenerateArgument<size_t>(const size_t, const InputGenerator&);
+template BufferRaw TunerImpl::GenerateArgument<half>(const size_t, const InputGenerator&);
+template BufferRaw TunerImpl::GenerateArgument<float>(const size_t, const InputGenerator&);
+template BufferRaw TunerImpl::GenerateArgument<double>(const size_t, const InputGenerator&);
+template BufferRaw TunerImpl::GenerateArgument<float2>(const size_t, const InputGenerator&);
+template BufferRaw TunerImpl::GenerateArgument<double2>(const size_t, const InputGenerator&);
+
 // =================================================================================================
 
 // Uploads a copy of the output vector to the device. This is done because the output might as well
@@ -622,7 +1648,8 @@ void TunerImpl::RunReferenceKernel() {
 // before each run.
 template <typename T>
 KernelInfo::MemArgument TunerImpl::CopyOutputBuffer(KernelInfo::MemArgument &argument) {
-  auto buffer_copy = Buffer<T>(context_, BufferAccess::kNotOwned, argument.size);
+  TRACE_SPAN("tuner", "CopyOutputBuffer");
+  auto buffer_copy = Buffer<T>(context_, BufferAccess::kNotOwned, argument.size, buffer_memory_);
   auto buffer_source = Buffer<T>(argument.buffer);
   buffer_source.CopyTo(queue_, argument.size, buffer_copy);
   auto result = KernelInfo::MemArgument{argument.index, argument.size, argument.type, buffer_copy()};
@@ -634,25 +1661,28 @@ KernelInfo::MemArgument TunerImpl::CopyOutputBuffer(KernelInfo::MemArgument &arg
 // Loops over all reference outputs, creates per output a new host buffer and copies the device
 // buffer from the device onto the host. This function is specialised for different data-types.
 void TunerImpl::StoreReferenceOutput() {
-  reference_outputs_.clear();
+  auto outputs = std::make_shared<ReferenceOutputs>();
   for (auto &output_buffer: arguments_output_copy_) {
     switch (output_buffer.type) {
-      case MemType::kShort: DownloadReference<short>(output_buffer); break;
-      case MemType::kInt: DownloadReference<int>(output_buffer); break;
-      case MemType::kSizeT: DownloadReference<size_t>(output_buffer); break;
-      case MemType::kHalf: DownloadReference<half>(output_buffer); break;
-      case MemType::kFloat: DownloadReference<float>(output_buffer); break;
-      case MemType::kDouble: DownloadReference<double>(output_buffer); break;
-      case MemType::kFloat2: DownloadReference<float2>(output_buffer); break;
-      case MemType::kDouble2: DownloadReference<double2>(output_buffer); break;
+      case MemType::kShort: DownloadReference<short>(output_buffer, *outputs); break;
+      case MemType::kInt: DownloadReference<int>(output_buffer, *outputs); break;
+      case MemType::kSizeT: DownloadReference<size_t>(output_buffer, *outputs); break;
+      case MemType::kHalf: DownloadReference<half>(output_buffer, *outputs); break;
+      case MemType::kFloat: DownloadReference<float>(output_buffer, *outputs); break;
+      case MemType::kDouble: DownloadReference<double>(output_buffer, *outputs); break;
+      case MemType::kFloat2: DownloadReference<float2>(output_buffer, *outputs); break;
+      case MemType::kDouble2: DownloadReference<double2>(output_buffer, *outputs); break;
       default: throw std::runtime_error("Unsupported reference output data-type");
     }
   }
+  SetReferenceOutputs(outputs);
 }
-template <typename T> void TunerImpl::DownloadReference(KernelInfo::MemArgument &device_buffer) {
-  auto host_buffer = new T[device_buffer.size];
-  Buffer<T>(device_buffer.buffer).Read(queue_, device_buffer.size, host_buffer);
-  reference_outputs_.push_back(host_buffer);
+template <typename T>
+void TunerImpl::DownloadReference(KernelInfo::MemArgument &device_buffer,
+                                  ReferenceOutputs &outputs) {
+  auto host_buffer = static_cast<T*>(outputs.AddOutput(device_buffer.size * sizeof(T)));
+  ReadSample(device_buffer, OutputSample{{0}, device_buffer.size}, host_buffer);
+  queue_.Finish();
 }
 
 // =================================================================================================
@@ -662,6 +1692,7 @@ template <typename T> void TunerImpl::DownloadReference(KernelInfo::MemArgument
 // compares the results to the reference output. This function is specialised for different
 // data-types. These functions return "true" if everything is OK, and "false" if there is a warning.
 bool TunerImpl::VerifyOutput() {
+  TRACE_SPAN("verification", "VerifyOutput");
   auto status = true;
   if (has_reference_) {
     auto i = size_t{0};
@@ -679,6 +1710,7 @@ bool TunerImpl::VerifyOutput() {
       }
       ++i;
     }
+    status &= CompareStagedOutputs(streamed_outputs_, i);
   }
   return status;
 }
@@ -686,39 +1718,301 @@ bool TunerImpl::VerifyOutput() {
 // See above comment
 template <typename T>
 bool TunerImpl::DownloadAndCompare(KernelInfo::MemArgument &device_buffer, const size_t i) {
-  auto l2_norm = 0.0;
 
-  // Downloads the results to the host
-  std::vector<T> host_buffer(device_buffer.size);
-  Buffer<T>(device_buffer.buffer).Read(queue_, device_buffer.size, host_buffer);
-  T* reference_output = static_cast<T*>(reference_outputs_[i]);
+  // Full outputs of zero-copy buffers are compared in place
+  auto sample = SampleOutput(device_buffer.size);
+  if (buffer_memory_ == BufferMemory::kHost && sample.chunk == device_buffer.size) {
+    auto buffer = Buffer<T>(device_buffer.buffer);
+    auto mapped_buffer = buffer.Map(queue_, BufferMapping::kRead, device_buffer.size);
+    auto status = CompareOutput(mapped_buffer, sample, i);
+    buffer.Unmap(queue_, mapped_buffer);
+    return status;
+  }
+
+  // Downloads the (sampled) results to the host
+  std::vector<T> host_buffer(sample.size());
+  ReadSample(device_buffer, sample, host_buffer.data());
+  queue_.Finish();
+  return CompareOutput(host_buffer.data(), sample, i);
+}
 
-  // Compares the results (L2 norm)
-  if (verification_method_ == VerificationMethod::AbsoluteDifference) {
-    for (auto j = size_t{ 0 }; j<device_buffer.size; ++j) {
-      l2_norm += AbsoluteDifference(reference_output[j], host_buffer[j]);
+// Compares a downloaded output sample to the same elements of the i-th reference output. This only
+// reads host data and can thus also be called from the verification thread. In case of sampling,
+// the L2 norm is computed over the sampled elements only.
+template <typename T>
+bool TunerImpl::CompareOutput(const T* host_buffer, const OutputSample &sample, const size_t i) {
+  auto l2_norm = 0.0;
+  auto reference_output = static_cast<const T*>(reference_outputs_.get()->Data(i));
+  for (auto c = size_t{0}; c < sample.offsets.size(); ++c) {
+    auto reference_chunk = reference_output + sample.offsets[c];
+    auto host_chunk = host_buffer + c * sample.chunk;
+    for (auto j = size_t{0}; j < sample.chunk; ++j) {
+      auto difference = AbsoluteDifference(reference_chunk[j], host_chunk[j]);
+
+      // Compares the results side by side
+      if (verification_method_ == VerificationMethod::SideBySide) {
+        if (difference > tolerance_treshold_) {
+          auto position = sample.offsets[c] + j;
+          fprintf(stderr, "%s Different results for position %zu in output: difference is %.8lf\n",
+                  kMessageWarning.c_str(), position, difference);
+          return false;
+        }
+      }
+      else {
+        l2_norm += difference;
+      }
     }
+  }
 
-    // Verifies if everything was OK, if not: print the L2 norm
+  // Verifies if everything was OK, if not: print the L2 norm
+  if (verification_method_ == VerificationMethod::AbsoluteDifference) {
     if (std::isnan(l2_norm) || l2_norm > tolerance_treshold_) {
       fprintf(stderr, "%s Results differ: L2 norm is %6.2e\n", kMessageWarning.c_str(), l2_norm);
       return false;
     }
-    return true;
   }
-  else if (verification_method_ == VerificationMethod::SideBySide) {
-    for (auto j = size_t{ 0 }; j<device_buffer.size; ++j)
-    {
-      if (AbsoluteDifference(reference_output[j], host_buffer[j]) > tolerance_treshold_) {
-        fprintf(stderr, "%s Different results for position %u in output: difference is %.8lf\n",
-                kMessageWarning.c_str(), j, AbsoluteDifference(reference_output[j], host_buffer[j]));
-        return false;
+  return true;
+}
+
+// =================================================================================================
+
+// Sampled verification: the number of ranges to verify follows from the probability of detecting
+// an output of which at least a fraction 'error_fraction_' of the elements is incorrect. A range
+// with a uniformly drawn start contains an incorrect element with a probability of at least that
+// fraction, wherever the incorrect elements are. The ranges are therefore counted as independent
+// draws, not their elements, which might all be correct or incorrect together. Returns the whole
+// output when the sample would not be smaller.
+size_t TunerImpl::SampleSize(const size_t size) const {
+  if (detection_probability_ >= 1.0) { return size; }
+  auto num_chunks = static_cast<size_t>(std::ceil(std::log(1.0 - detection_probability_) /
+                                                   std::log(1.0 - error_fraction_)));
+  num_chunks = std::max(num_chunks, size_t{1});
+  if (num_chunks * kSampleChunkSize >= size) { return size; }
+  return num_chunks * kSampleChunkSize;
+}
+
+// Selects ranges of elements of which each start is drawn independently from all possible starts,
+// such that the end of the output is covered as well. The starts are drawn from the seeded
+// generator, such that a tuning run can be reproduced, and sorted to read the output in order.
+TunerImpl::OutputSample TunerImpl::SampleOutput(const size_t size) {
+  auto sample_size = SampleSize(size);
+  if (sample_size == size) { return OutputSample{{0}, size}; }
+  auto starts = std::uniform_int_distribution<size_t>(0, size - kSampleChunkSize);
+  auto offsets = std::vector<size_t>(sample_size / kSampleChunkSize);
+  for (auto &offset: offsets) { offset = starts(sample_generator_); }
+  std::sort(offsets.begin(), offsets.end());
+  return OutputSample{offsets, kSampleChunkSize};
+}
+
+// Computes the probability with which the verification of the outputs of a kernel detects incorrect
+// results: 1 for a full verification and 0 without a reference to compare against. For a sample,
+// this is the probability that at least one of its ranges contains an incorrect element.
+double TunerImpl::VerificationConfidence(const KernelInfo &kernel) const {
+  if (!has_reference_) { return 0.0; }
+  auto confidence = 1.0;
+  for (auto &output: kernel.arguments_output()) {
+    auto sample_size = SampleSize(output.size);
+    if (sample_size < output.size) {
+      auto num_chunks = static_cast<double>(sample_size / kSampleChunkSize);
+      auto miss_probability = std::pow(1.0 - error_fraction_, num_chunks);
+      confidence = std::min(confidence, 1.0 - miss_probability);
+    }
+  }
+  return confidence;
+}
+
+// Downloads an output sample a-synchronously: a read per range. Zero-copy buffers are instead
+// mapped (blocking) from the first to the last range and the ranges are copied from the mapping.
+template <typename T>
+void TunerImpl::ReadSample(KernelInfo::MemArgument &device_buffer, const OutputSample &sample,
+                           T* host_buffer) {
+  auto buffer = Buffer<T>(device_buffer.buffer);
+  if (buffer_memory_ == BufferMemory::kHost) {
+    auto first = sample.offsets.front();
+    auto span = sample.offsets.back() - first + sample.chunk;
+    auto mapped_buffer = buffer.Map(queue_, BufferMapping::kRead, span, first);
+    for (auto c = size_t{0}; c < sample.offsets.size(); ++c) {
+      auto chunk = mapped_buffer + (sample.offsets[c] - first);
+      std::copy(chunk, chunk + sample.chunk, host_buffer + c * sample.chunk);
+    }
+    buffer.Unmap(queue_, mapped_buffer);
+  }
+  else {
+    for (auto c = size_t{0}; c < sample.offsets.size(); ++c) {
+      buffer.ReadAsync(queue_, sample.chunk, host_buffer + c * sample.chunk, sample.offsets[c]);
+    }
+  }
+}
+
+// =================================================================================================
+
+// Pipelined verification: downloads the outputs of a run into a free staging buffer and compares
+// them on a host thread, such that the next configuration can already be compiled and launched.
+// Results are reported (printed and stored) in order, as soon as their own verification and that of
+// all earlier results have finished.
+void TunerImpl::VerifyOutputAsync(const TunerResult &tuning_result) {
+  TRACE_SPAN("verification", "VerifyOutputAsync");
+
+  // Waits until a staging buffer is free: the oldest verification owns the buffer to be used next
+  while (pending_verifications_.size() >= kStagingBuffers) { FinishVerification(); }
+  auto &staging_buffer = staging_buffers_[next_staging_buffer_];
+  next_staging_buffer_ = (next_staging_buffer_ + 1) % kStagingBuffers;
+
+  // Failed runs and runs without a reference are not verified at all
+  auto failed = (tuning_result.time == std::numeric_limits<float>::max() || tuning_result.timed_out);
+  if (failed || !has_reference_) {
+    auto verification = std::promise<bool>();
+    verification.set_value(!has_reference_);
+    pending_verifications_.push_back({tuning_result, verification.get_future()});
+  }
+
+  // Downloads the outputs and launches the comparison
+  else {
+    auto num_outputs = arguments_output_copy_.size();
+    staging_buffer.resize(num_outputs + streamed_outputs_.size());
+    for (auto i = size_t{0}; i < arguments_output_copy_.size(); ++i) {
+      auto &output_buffer = arguments_output_copy_[i];
+      auto &staged = staging_buffer[i];
+      staged.type = output_buffer.type;
+      staged.sample = SampleOutput(output_buffer.size);
+      switch (output_buffer.type) {
+        case MemType::kShort: StageOutput<short>(output_buffer, staged); break;
+        case MemType::kInt: StageOutput<int>(output_buffer, staged); break;
+        case MemType::kSizeT: StageOutput<size_t>(output_buffer, staged); break;
+        case MemType::kHalf: StageOutput<half>(output_buffer, staged); break;
+        case MemType::kFloat: StageOutput<float>(output_buffer, staged); break;
+        case MemType::kDouble: StageOutput<double>(output_buffer, staged); break;
+        case MemType::kFloat2: StageOutput<float2>(output_buffer, staged); break;
+        case MemType::kDouble2: StageOutput<double2>(output_buffer, staged); break;
+        default: throw std::runtime_error("Unsupported output data-type");
       }
     }
-    return true;
+
+    // Streamed outputs are already on the host: their memory is swapped with the staging buffer
+    for (auto o = size_t{0}; o < streamed_outputs_.size(); ++o) {
+      std::swap(staging_buffer[num_outputs + o], streamed_outputs_[o]);
+    }
+    // The downloads complete in the background: the queue is in-order, so the next configuration's
+    // commands on the output buffers only start after them
+    auto downloaded = Event();
+    queue_.Marker(downloaded);
+    queue_.Flush();
+    auto verification = std::async(std::launch::async, [this, &staging_buffer, downloaded]() {
+      TRACE_SPAN("verification", "CompareStagedOutputs");
+      downloaded.WaitForCompletion();
+      return CompareStagedOutputs(staging_buffer);
+    });
+    pending_verifications_.push_back({tuning_result, std::move(verification)});
+  }
+
+  // Reports the results which are done, in order
+  while (!pending_verifications_.empty()) {
+    auto &status = pending_verifications_.front().status;
+    if (status.wait_for(std::chrono::seconds(0)) != std::future_status::ready) { break; }
+    FinishVerification();
+  }
+}
+
+// Waits for the oldest pending verification and reports its result
+void TunerImpl::FinishVerification() {
+  auto &pending = pending_verifications_.front();
+  auto tuning_result = pending.result;
+  tuning_result.status = pending.status.get();
+  pending_verifications_.pop_front();
+  StoreResult(tuning_result);
+}
+
+// Downloads an output into a staging buffer (asynchronously, the caller synchronizes the queue)
+template <typename T>
+void TunerImpl::StageOutput(KernelInfo::MemArgument &device_buffer, StagedOutput &staged) {
+  staged.data.resize(staged.sample.size() * sizeof(T));
+  auto host_buffer = reinterpret_cast<T*>(staged.data.data());
+  ReadSample(device_buffer, staged.sample, host_buffer);
+}
+
+// Compares all outputs in a staging buffer against the reference outputs, starting at reference
+// output 'first'
+bool TunerImpl::CompareStagedOutputs(const std::vector<StagedOutput> &staging_buffer,
+                                     const size_t first) {
+  auto status = true;
+  for (auto i = first; i < first + staging_buffer.size(); ++i) {
+    auto &staged = staging_buffer[i - first];
+    switch (staged.type) {
+      case MemType::kShort: status &= CompareStagedOutput<short>(staged, i); break;
+      case MemType::kInt: status &= CompareStagedOutput<int>(staged, i); break;
+      case MemType::kSizeT: status &= CompareStagedOutput<size_t>(staged, i); break;
+      case MemType::kHalf: status &= CompareStagedOutput<half>(staged, i); break;
+      case MemType::kFloat: status &= CompareStagedOutput<float>(staged, i); break;
+      case MemType::kDouble: status &= CompareStagedOutput<double>(staged, i); break;
+      case MemType::kFloat2: status &= CompareStagedOutput<float2>(staged, i); break;
+      case MemType::kDouble2: status &= CompareStagedOutput<double2>(staged, i); break;
+      default: throw std::runtime_error("Unsupported output data-type");
+    }
+  }
+  return status;
+}
+template <typename T>
+bool TunerImpl::CompareStagedOutput(const StagedOutput &staged, const size_t i) {
+  return CompareOutput(reinterpret_cast<const T*>(staged.data.data()), staged.sample, i);
+}
+
+// =================================================================================================
+
+// Deferred verification: re-runs and verifies the fastest configurations until 'verify_top_k_' of
+// them are correct, followed by a random sample of the others as an audit. The sample is drawn with
+// the seeded generator of the sampled verification, such that it is reproducible. All other results
+// stay unverified: their status is false, such that they are never selected as the best result.
+void TunerImpl::VerifyDeferred(const size_t id, const size_t first_result) {
+  auto candidates = std::vector<size_t>();
+  for (auto r = first_result; r < tuning_results_.size(); ++r) {
+    if (tuning_results_[r].unverified) { candidates.push_back(r); }
+  }
+  std::sort(candidates.begin(), candidates.end(), [this](const size_t a, const size_t b) {
+    return tuning_results_[a].time < tuning_results_[b].time;
+  });
+
+  // Verifies the fastest configurations
+  PrintHeader("Verifying the fastest " + std::to_string(verify_top_k_) + " configuration(s)");
+  auto num_correct = size_t{0};
+  auto c = size_t{0};
+  for (; c < candidates.size() && num_correct < verify_top_k_; ++c) {
+    if (VerifyResult(id, tuning_results_[candidates[c]])) { ++num_correct; }
+  }
+
+  // Audits a random sample of the remaining configurations
+  auto remaining = std::vector<size_t>(candidates.begin() + c, candidates.end());
+  auto num_audits = static_cast<size_t>(std::ceil(audit_fraction_ * remaining.size()));
+  if (num_audits == 0) { return; }
+  PrintHeader("Auditing " + std::to_string(num_audits) + " random other configuration(s)");
+  std::shuffle(remaining.begin(), remaining.end(), sample_generator_);
+  auto num_incorrect = size_t{0};
+  for (auto a = size_t{0}; a < num_audits; ++a) {
+    if (!VerifyResult(id, tuning_results_[remaining[a]])) { ++num_incorrect; }
   }
+  if (num_incorrect > 0) {
+    fprintf(stdout, "%s Audit found %zu incorrect configuration(s): consider verifying all\n",
+            kMessageWarning.c_str(), num_incorrect);
+  }
+}
+
+// Re-runs the configuration of a result and verifies its output. Sets and returns the status.
+bool TunerImpl::VerifyResult(const size_t id, TunerResult &result) {
+  auto &kernel = kernels_.at(id);
+  auto source = GetConfiguredKernelSource(id, result.configuration);
+  kernel.ComputeRanges(result.configuration);
+  kernel.SetNumCurrentIterations(result.configuration);
+  kernel.SetNumCurrentChunks(result.configuration);
+  auto rerun_result = RunKernel(source, kernel, 0, 1);
+  auto completed = (rerun_result.time != std::numeric_limits<float>::max() &&
+                    !rerun_result.timed_out);
+  result.status = completed && VerifyOutput();
+  result.unverified = false;
+  if (!result.status) { PrintResult(stdout, result, kMessageWarning); }
+  return result.status;
 }
 
+// =================================================================================================
+
 // Computes the absolute difference
 template <typename T>
 double TunerImpl::AbsoluteDifference(const T reference, const T result) {
@@ -856,8 +2150,9 @@ void TunerImpl::ModelPrediction(const Model model_type, const float validation_f
       }
       source += kernel.source();
 
-      // Updates the local range with the parameter values
+      // Updates the local range and the number of streamed chunks with the parameter values
       kernel.ComputeRanges(permutation);
+      kernel.SetNumCurrentChunks(permutation);
 
       // Compiles and runs the kernel
       auto tuning_result = RunKernel(source, kernel, pid, test_top_x_configurations);
@@ -887,6 +2182,20 @@ void TunerImpl::PrintResult(FILE* fp, const TunerResult &result, const std::stri
   for (auto &setting: result.configuration) {
     fprintf(fp, "%9s;", setting.GetConfig().c_str());
   }
+  if (result.confidence > 0.0 && result.confidence < 1.0) {
+    fprintf(fp, " verified with %.4lf%% confidence;", 100.0 * result.confidence);
+  }
+  if (memory_budget_ != 0) {
+    fprintf(fp, " peak memory %.1lf MB;", static_cast<double>(result.peak_memory) / (1024 * 1024));
+  }
+  if (energy_meter_) {
+    fprintf(fp, " %.3lf J at %.1lf W;", result.energy, result.power);
+  }
+  if (!pareto_objectives_.empty()) {
+    fprintf(fp, " compiled in %.1lf ms; %zu bytes local memory;", result.compile_time,
+            result.local_memory);
+  }
+  if (result.unverified) { fprintf(fp, " not verified yet;"); }
   fprintf(fp, "\n");
 }
 
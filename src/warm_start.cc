@@ -0,0 +1,113 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author: agent@local (agent)
+//
+// This file implements the reader of previous tuning results (see the header for information about
+// the format).
+//
+// -------------------------------------------------------------------------------------------------
+//
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// =================================================================================================
+
+// The corresponding header file
+#include "internal/warm_start.h"
+
+#include <algorithm> // std::stable_sort
+#include <fstream> // std::ifstream
+#include <iterator> // std::istreambuf_iterator
+#include <cstdlib> // std::strtod, std::strtoull
+#include <utility> // std::pair
+#include <stdexcept> // std::runtime_error
+
+namespace cltune {
+// =================================================================================================
+
+// The keys as written by PrintJSON. The kernel key includes the opening quote of its value, which
+// distinguishes it from the kernel time within the timings.
+const std::string kKernelKey = "\"kernel\": \"";
+const std::string kTimeKey = "\"time\": ";
+const std::string kParametersKey = "\"parameters\": {";
+
+// Reads the time of a result, or returns a negative time if it has none
+static double ReadTime(const std::string &result) {
+  auto position = result.find(kTimeKey);
+  if (position == std::string::npos) { return -1.0; }
+  return std::strtod(result.c_str() + position + kTimeKey.size(), nullptr);
+}
+
+// Reads the "name": value pairs of the parameters of a result
+static ParameterRange ReadParameters(const std::string &result) {
+  auto parameters = ParameterRange();
+  auto position = result.find(kParametersKey);
+  if (position == std::string::npos) { return parameters; }
+  auto end = result.find('}', position);
+  position = result.find('"', position + kParametersKey.size());
+  while (position < end) {
+    auto name_end = result.find('"', position + 1);
+    auto value = result.find(':', name_end);
+    if (name_end == std::string::npos || value == std::string::npos) { break; }
+    auto name = result.substr(position + 1, name_end - position - 1);
+    auto number = static_cast<size_t>(std::strtoull(result.c_str() + value + 1, nullptr, 10));
+    parameters.push_back({name, number});
+    position = result.find('"', value);
+  }
+  return parameters;
+}
+
+// =================================================================================================
+
+// Each result starts with its kernel name and ends where the next result starts
+std::vector<ParameterRange> ReadWarmStart(const std::string &filename, const std::string &kernel) {
+  std::ifstream file(filename);
+  if (!file) { throw std::runtime_error("Could not open results file: " + filename); }
+  auto text = std::string{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  auto position = text.find("\"results\"");
+  if (position == std::string::npos) {
+    throw std::runtime_error("Not a results file (see PrintJSON): " + filename);
+  }
+
+  auto results = std::vector<std::pair<double, ParameterRange>>();
+  position = text.find(kKernelKey, position);
+  while (position != std::string::npos) {
+    auto name = position + kKernelKey.size();
+    auto name_end = text.find('"', name);
+    if (name_end == std::string::npos) {
+      throw std::runtime_error("Invalid result in results file: " + filename);
+    }
+    auto next = text.find(kKernelKey, name_end);
+    if (text.compare(name, name_end - name, kernel) == 0) {
+      auto result = text.substr(name_end, (next == std::string::npos) ? next : next - name_end);
+      auto time = ReadTime(result);
+      auto parameters = ReadParameters(result);
+      if (time >= 0.0 && !parameters.empty()) { results.push_back({time, parameters}); }
+    }
+    position = next;
+  }
+
+  std::stable_sort(results.begin(), results.end(),
+                   [](const std::pair<double, ParameterRange> &a,
+                      const std::pair<double, ParameterRange> &b) { return a.first < b.first; });
+  auto configurations = std::vector<ParameterRange>();
+  for (auto &result: results) { configurations.push_back(result.second); }
+  return configurations;
+}
+
+// =================================================================================================
+} // namespace cltune
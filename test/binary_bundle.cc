@@ -0,0 +1,98 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author(s):
+//   agent <agent@local>
+//
+// This file tests the BinaryBundle class: saving programs into a bundle file and reading them back.
+//
+// =================================================================================================
+
+#include "catch.hpp"
+
+#include "internal/binary_bundle.h"
+
+#include <cstdio> // std::remove, fopen, fread, fwrite
+#include <cstdint> // uint64_t
+#include <stdexcept> // std::runtime_error
+
+// Settings
+const std::string kBundleFile = "/tmp/cltune_bundle_test.bin";
+
+// =================================================================================================
+
+SCENARIO("programs can be saved into a binary bundle", "[BinaryBundle]") {
+  GIVEN("The programs of two kernels, one of them for two drivers") {
+    auto binary = std::string(1000, '\0');
+    for (auto i = size_t{0}; i < binary.size(); ++i) { binary[i] = static_cast<char>(i * 7); }
+    auto entries = std::vector<cltune::BundleEntry>{
+      {"gemm", "Tesla K40m", "352.39", "#define MWG 64\n__kernel void gemm() {}", binary},
+      {"gemm", "Tesla K40m", "361.42", "#define MWG 64\n__kernel void gemm() {}", "other"},
+      {"copy", "Tesla K40m", "352.39", "__kernel void copy() {}", ""}
+    };
+
+    WHEN("they are saved into a bundle file") {
+      cltune::BinaryBundle::Save(kBundleFile, entries);
+
+      THEN("the bundle holds the same programs") {
+        cltune::BinaryBundle bundle(kBundleFile);
+        auto loaded = bundle.Entries();
+        REQUIRE(loaded.size() == entries.size());
+        for (auto e = size_t{0}; e < entries.size(); ++e) {
+          REQUIRE(loaded[e].kernel == entries[e].kernel);
+          REQUIRE(loaded[e].device == entries[e].device);
+          REQUIRE(loaded[e].driver == entries[e].driver);
+          REQUIRE(loaded[e].source == entries[e].source);
+          REQUIRE(loaded[e].binary == entries[e].binary);
+        }
+      }
+      std::remove(kBundleFile.c_str());
+    }
+  }
+
+  GIVEN("A file which is not a bundle") {
+    auto file = fopen(kBundleFile.c_str(), "w");
+    fprintf(file, "not a bundle, but long enough to hold a header\n");
+    fclose(file);
+    THEN("it cannot be loaded") {
+      REQUIRE_THROWS_AS(cltune::BinaryBundle{kBundleFile}, std::runtime_error);
+    }
+    std::remove(kBundleFile.c_str());
+  }
+
+  GIVEN("A bundle of which the index of 256 entries (20480 bytes) follows the 16-byte header") {
+    cltune::BinaryBundle::Save(kBundleFile, {});
+    auto file = fopen(kBundleFile.c_str(), "rb");
+    auto header = std::vector<uint64_t>(2);
+    REQUIRE(fread(header.data(), sizeof(uint64_t), 2, file) == 2);
+    fclose(file);
+    auto words = std::vector<uint64_t>((16 + 20480) / sizeof(uint64_t), 0);
+    words[0] = header[0];
+    words[1] = 256;
+    auto write_words = [&words]() {
+      auto bundle_file = fopen(kBundleFile.c_str(), "wb");
+      fwrite(words.data(), sizeof(uint64_t), words.size(), bundle_file);
+      fclose(bundle_file);
+    };
+
+    WHEN("the file is truncated to the size of the index only") {
+      words.resize(20480 / sizeof(uint64_t));
+      write_words();
+      THEN("it cannot be loaded") {
+        REQUIRE_THROWS_AS(cltune::BinaryBundle{kBundleFile}, std::runtime_error);
+      }
+    }
+    WHEN("the file holds both the header and the index") {
+      write_words();
+      THEN("all entries are loaded") {
+        cltune::BinaryBundle bundle(kBundleFile);
+        REQUIRE(bundle.Entries().size() == 256);
+      }
+    }
+    std::remove(kBundleFile.c_str());
+  }
+}
+
+// =================================================================================================
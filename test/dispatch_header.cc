@@ -0,0 +1,68 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author(s):
+//   agent <agent@local>
+//
+// This file tests the generator of dispatch headers: reading the entries of a generated header
+// back and merging new entries into it.
+//
+// =================================================================================================
+
+#include "catch.hpp"
+
+#include "internal/dispatch_header.h"
+
+#include <cstdio> // std::remove
+
+// Settings
+const std::string kDispatchFile = "/tmp/cltune_dispatch_test.h";
+
+// =================================================================================================
+
+SCENARIO("dispatch headers can be generated and merged", "[DispatchHeader]") {
+  GIVEN("A header with the configurations of two kernels") {
+    auto entries = std::vector<cltune::DispatchEntry>{
+      {"gemm", "Tesla K40m", "large", 1.5f, {{"MWG", 64}, {"NWG", 128}, {"VWM", 4}}},
+      {"copy", "Tesla K40m", "large", 0.25f, {}}
+    };
+    cltune::WriteDispatchHeader(kDispatchFile, entries);
+
+    WHEN("it is read back") {
+      auto read = cltune::ReadDispatchHeader(kDispatchFile);
+      THEN("the entries are the same") {
+        REQUIRE(read.size() == entries.size());
+        for (auto e = size_t{0}; e < entries.size(); ++e) {
+          REQUIRE(read[e].kernel == entries[e].kernel);
+          REQUIRE(read[e].device == entries[e].device);
+          REQUIRE(read[e].size_class == entries[e].size_class);
+          REQUIRE(read[e].time == Approx(entries[e].time));
+          REQUIRE(read[e].parameters == entries[e].parameters);
+        }
+      }
+    }
+
+    WHEN("new configurations are added") {
+      auto read = cltune::ReadDispatchHeader(kDispatchFile);
+      cltune::AddDispatchEntry(read, {"gemm", "Tesla K40m", "large", 1.25f, {{"MWG", 32}}});
+      cltune::AddDispatchEntry(read, {"gemm", "Tesla K40m", "small", 0.5f, {{"MWG", 16}}});
+      THEN("the configuration of the same kernel, device and size class is replaced") {
+        REQUIRE(read.size() == 3);
+        REQUIRE(read[0].parameters.size() == 1);
+        REQUIRE(read[0].parameters[0].second == 32);
+        REQUIRE(read[2].size_class == "small");
+      }
+    }
+    std::remove(kDispatchFile.c_str());
+  }
+
+  GIVEN("A file which does not exist") {
+    THEN("it has no entries") {
+      REQUIRE(cltune::ReadDispatchHeader("/tmp/cltune_no_such_dispatch.h").empty());
+    }
+  }
+}
+
+// =================================================================================================
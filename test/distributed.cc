@@ -0,0 +1,112 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author(s):
+//   agent <agent@local>
+//
+// This file tests the Coordinator and Worker classes over a loopback Unix-domain socket. The
+// workers are forked processes which report a fake execution time based on the configuration.
+//
+// =================================================================================================
+
+#include "catch.hpp"
+
+#include "internal/distributed.h"
+
+#ifndef _WIN32
+  #include <unistd.h> // fork, _exit, sleep
+  #include <sys/wait.h> // waitpid
+#endif
+
+// Settings
+const std::string kAddress = "unix:/tmp/cltune_test_distributed.socket";
+const size_t kNumWorkers = 3;
+const size_t kBatchSize = 16;
+const size_t kHangingValue = 99;
+
+// Runs a worker which answers with time 'value + 1', optionally disconnecting after a few jobs. The
+// worker hangs for a while on a specific value.
+void RunFakeWorker(const size_t max_jobs) {
+  auto worker = cltune::Worker(kAddress, "fake device");
+  auto sequence = size_t{0};
+  auto kernel_id = size_t{0};
+  auto configuration = cltune::KernelInfo::Configuration();
+  for (auto jobs = size_t{0}; jobs < max_jobs && worker.Receive(sequence, kernel_id, configuration);
+       ++jobs) {
+    if (configuration[0].value == kHangingValue) { sleep(2); }
+    auto time = static_cast<float>(configuration[0].value + 1);
+    worker.Send(sequence, cltune::WorkerResult{time, configuration.size(), true, "", false, 0,
+                                               std::vector<float>(cltune::kNumTimings, time),
+                                               2.0f * time, 0.5f, 1.0f, 64});
+  }
+}
+
+// =================================================================================================
+
+#ifndef _WIN32
+SCENARIO("configurations can be evaluated by workers", "[Distributed]") {
+  GIVEN("A coordinator with several local workers, of which one gets lost") {
+    auto coordinator = std::unique_ptr<cltune::Coordinator>(new cltune::Coordinator(kAddress));
+    auto pids = std::vector<pid_t>();
+    for (auto w = size_t{0}; w < kNumWorkers; ++w) {
+      auto pid = fork();
+      if (pid == 0) {
+        RunFakeWorker((w == 0) ? 2 : kBatchSize * 4);
+        _exit(0);
+      }
+      pids.push_back(pid);
+    }
+
+    WHEN("batches of configurations are evaluated") {
+      auto batch = std::vector<cltune::KernelInfo::Configuration>();
+      for (auto i = size_t{0}; i < kBatchSize; ++i) {
+        batch.push_back({cltune::KernelInfo::Setting{"PARAM", i}, {"OTHER", 2}});
+      }
+      auto results = coordinator->Evaluate(0, batch);
+      auto results_again = coordinator->Evaluate(0, batch);
+
+      THEN("all results are returned in the order of the batch") {
+        REQUIRE(results.size() == kBatchSize);
+        REQUIRE(results_again.size() == kBatchSize);
+        for (auto i = size_t{0}; i < kBatchSize; ++i) {
+          REQUIRE(results[i].time == static_cast<float>(i + 1));
+          REQUIRE(results[i].threads == 2);
+          REQUIRE(results[i].status == true);
+          REQUIRE(results[i].timings.size() == cltune::kNumTimings);
+          REQUIRE(results[i].timings.back() == static_cast<float>(i + 1));
+          REQUIRE(results[i].energy == 2.0f * static_cast<float>(i + 1));
+          REQUIRE(results[i].local_memory == 64);
+          REQUIRE(results_again[i].time == static_cast<float>(i + 1));
+        }
+      }
+    }
+
+    WHEN("a configuration hangs with the watchdog enabled") {
+      coordinator->SetWatchdog(1, 500.0f);
+      auto batch = std::vector<cltune::KernelInfo::Configuration>();
+      for (auto value: {size_t{0}, kHangingValue, size_t{1}, size_t{2}}) {
+        batch.push_back({cltune::KernelInfo::Setting{"PARAM", value}});
+      }
+      auto results = coordinator->Evaluate(0, batch);
+
+      THEN("it is marked as failed with a reason and the others complete") {
+        REQUIRE(results.size() == batch.size());
+        REQUIRE(results[1].status == false);
+        REQUIRE(results[1].timed_out == true);
+        REQUIRE(results[1].failure_reason.find("timed out") != std::string::npos);
+        REQUIRE(results[0].time == 1.0f);
+        REQUIRE(results[2].time == 2.0f);
+        REQUIRE(results[3].time == 3.0f);
+      }
+    }
+
+    // Tells the workers to stop before waiting for them
+    coordinator.reset();
+    for (auto &pid: pids) { waitpid(pid, nullptr, 0); }
+  }
+}
+#endif
+
+// =================================================================================================
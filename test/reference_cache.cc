@@ -0,0 +1,64 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author(s):
+//   agent <agent@local>
+//
+// This file tests the ReferenceOutputs and ReferenceCache classes: storing outputs in memory and
+// reloading them from a cache file on disk.
+//
+// =================================================================================================
+
+#include "catch.hpp"
+
+#include "internal/reference_cache.h"
+
+#include <cstdio> // std::remove
+#include <cstring> // std::memcpy
+
+// Settings
+const std::string kDirectory = "/tmp";
+const std::string kKey = "reference kernel\nsource\n64 / 8\ninput 4 256 123\n";
+
+// =================================================================================================
+
+SCENARIO("reference outputs can be cached", "[ReferenceCache]") {
+  GIVEN("The outputs of a reference run") {
+    auto first = std::vector<float>{1.0f, 2.0f, 3.0f};
+    auto second = std::vector<int>{7, 8, 9, 10, 11};
+    auto outputs = std::make_shared<cltune::ReferenceOutputs>();
+    std::memcpy(outputs->AddOutput(first.size() * sizeof(float)), first.data(),
+                first.size() * sizeof(float));
+    std::memcpy(outputs->AddOutput(second.size() * sizeof(int)), second.data(),
+                second.size() * sizeof(int));
+
+    WHEN("they are stored in a cache with a directory") {
+      auto cache = cltune::ReferenceCache();
+      cache.SetDirectory(kDirectory);
+      cache.Store(kKey, outputs);
+
+      THEN("they can be found in memory by their key only") {
+        REQUIRE(cache.Find(kKey) == outputs);
+        REQUIRE(cache.Find(kKey + "other") == nullptr);
+      }
+
+      THEN("a new cache finds them on disk with the same contents") {
+        auto new_cache = cltune::ReferenceCache();
+        new_cache.SetDirectory(kDirectory);
+        auto loaded = new_cache.Find(kKey);
+        REQUIRE(loaded != nullptr);
+        REQUIRE(loaded->NumOutputs() == 2);
+        REQUIRE(loaded->Size(0) == first.size() * sizeof(float));
+        REQUIRE(loaded->Size(1) == second.size() * sizeof(int));
+        auto loaded_first = static_cast<const float*>(loaded->Data(0));
+        auto loaded_second = static_cast<const int*>(loaded->Data(1));
+        for (auto i = size_t{0}; i < first.size(); ++i) { REQUIRE(loaded_first[i] == first[i]); }
+        for (auto i = size_t{0}; i < second.size(); ++i) { REQUIRE(loaded_second[i] == second[i]); }
+      }
+    }
+  }
+}
+
+// =================================================================================================
@@ -0,0 +1,93 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author(s):
+//   agent <agent@local>
+//
+// This file tests the Pareto front tracking and the starting points of the Searcher class, using a
+// full search and simulated annealing.
+//
+// =================================================================================================
+
+#include "catch.hpp"
+
+#include "internal/searchers/full_search.h"
+#include "internal/searchers/annealing.h"
+
+#include <algorithm> // std::sort
+
+// =================================================================================================
+
+SCENARIO("searchers keep track of the Pareto front", "[Searcher]") {
+  GIVEN("A full search over five configurations") {
+    auto configurations = cltune::Searcher::Configurations();
+    for (auto i = size_t{0}; i < 5; ++i) {
+      configurations.push_back({cltune::KernelInfo::Setting{"PARAM", i}});
+    }
+    auto searcher = cltune::FullSearch(configurations);
+
+    // Objectives (time, compile time) of each configuration: the third is dominated by the first,
+    // the fourth has failed, and the last replaces the second
+    auto objectives = std::vector<std::vector<double>>{{1.0, 9.0}, {2.0, 5.0}, {3.0, 9.0}, {},
+                                                       {2.0, 4.0}};
+    auto times = std::vector<double>{1.0, 2.0, 3.0, 1.0e9, 2.0};
+
+    WHEN("the objectives are pushed one batch at a time") {
+      searcher.PushBatch(std::vector<double>(times.begin(), times.begin() + 3),
+                         std::vector<std::vector<double>>(objectives.begin(),
+                                                          objectives.begin() + 3));
+      auto front_before = searcher.pareto_front();
+      searcher.PushBatch(std::vector<double>(times.begin() + 3, times.end()),
+                         std::vector<std::vector<double>>(objectives.begin() + 3,
+                                                          objectives.end()));
+
+      THEN("the front contains the non-dominated configurations only") {
+        REQUIRE(front_before == std::vector<size_t>({0, 1}));
+        REQUIRE(searcher.pareto_front() == std::vector<size_t>({0, 4}));
+        REQUIRE(cltune::Searcher::ParetoFront(objectives) == std::vector<size_t>({0, 4}));
+      }
+    }
+  }
+}
+
+// =================================================================================================
+
+SCENARIO("searchers start from the given starting points", "[Searcher]") {
+  GIVEN("Five configurations and starting points of which one is outside of the search space") {
+    auto configurations = cltune::Searcher::Configurations();
+    for (auto i = size_t{0}; i < 5; ++i) {
+      configurations.push_back({cltune::KernelInfo::Setting{"PARAM", i}});
+    }
+    auto points = cltune::Searcher::Configurations{{cltune::KernelInfo::Setting{"PARAM", 3}},
+                                                   {cltune::KernelInfo::Setting{"PARAM", 7}},
+                                                   {cltune::KernelInfo::Setting{"PARAM", 1}}};
+
+    WHEN("a full search is seeded") {
+      auto searcher = cltune::FullSearch(configurations);
+      searcher.SetStartingPoints(points);
+      auto values = std::vector<size_t>();
+      for (auto i = size_t{0}; i < searcher.NumConfigurations(); ++i) {
+        values.push_back(searcher.GetConfiguration()[0].value);
+        searcher.PushExecutionTime(1.0);
+        searcher.CalculateNextIndex();
+      }
+      THEN("the starting points are evaluated first, and all configurations once") {
+        REQUIRE(values[0] == 3);
+        REQUIRE(values[1] == 1);
+        std::sort(values.begin(), values.end());
+        REQUIRE(values == std::vector<size_t>({0, 1, 2, 3, 4}));
+      }
+    }
+    WHEN("simulated annealing is seeded") {
+      auto searcher = cltune::Annealing(configurations, 1.0, 4.0);
+      searcher.SetStartingPoints(points);
+      THEN("it starts from the best starting point") {
+        REQUIRE(searcher.GetConfiguration()[0].value == 3);
+      }
+    }
+  }
+}
+
+// =================================================================================================
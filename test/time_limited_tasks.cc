@@ -0,0 +1,85 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author(s):
+//   agent <agent@local>
+//
+// This file tests the TimeLimitedTasks class, which the tuner uses to abandon compilations which
+// exceed the compilation time limit. The tasks sleep instead of compiling.
+//
+// =================================================================================================
+
+#include "catch.hpp"
+
+#include "internal/time_limited_tasks.h"
+
+#include <atomic> // std::atomic
+#include <chrono> // std::chrono::milliseconds
+#include <thread> // std::this_thread::sleep_for
+#include <stdexcept> // std::runtime_error
+
+// =================================================================================================
+
+SCENARIO("tasks exceeding the time limit are abandoned", "[TimeLimitedTasks]") {
+  GIVEN("Tasks allowing at most one abandoned task") {
+
+    // A slow task runs until it is released (or for at most 10 seconds). The flags are declared
+    // before the tasks, such that they outlive the abandoned tasks.
+    std::atomic<bool> release(false);
+    std::atomic<bool> slow_finished(false);
+    std::atomic<bool> second_finished(false);
+    auto slow_task = [&release, &slow_finished]() {
+      for (auto i = 0; i < 10000 && !release; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      slow_finished = true;
+    };
+    cltune::TimeLimitedTasks tasks(1);
+
+    WHEN("a task finishes within the limit") {
+      auto finished = false;
+      THEN("it is not abandoned") {
+        REQUIRE(tasks.Run([&finished]() { finished = true; }, 10000.0f) == true);
+        REQUIRE(finished == true);
+        REQUIRE(tasks.NumAbandoned() == 0);
+      }
+    }
+    WHEN("a task throws") {
+      THEN("its exception is passed on") {
+        REQUIRE_THROWS_AS(tasks.Run([]() { throw std::runtime_error("failed"); }, 10000.0f),
+                          std::runtime_error);
+      }
+    }
+    WHEN("a task exceeds the limit") {
+      REQUIRE(tasks.Run(slow_task, 10.0f) == false);
+      THEN("the next task runs before the abandoned one finishes") {
+        auto next_finished = false;
+        REQUIRE(tasks.Run([&next_finished]() { next_finished = true; }, 10000.0f) == true);
+        REQUIRE(next_finished == true);
+        REQUIRE(slow_finished == false);
+        REQUIRE(tasks.NumAbandoned() == 1);
+        release = true;
+        tasks.WaitForSlot();
+        REQUIRE(slow_finished == true);
+        REQUIRE(tasks.NumAbandoned() == 0);
+      }
+      THEN("the next abandoned task waits for it when the maximum is reached") {
+        release = true;
+        auto second_task = [&second_finished]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(200));
+          second_finished = true;
+        };
+        REQUIRE(tasks.Run(second_task, 10.0f) == false);
+        REQUIRE(slow_finished == true);
+        REQUIRE(tasks.NumAbandoned() == 1);
+        tasks.WaitForSlot();
+        REQUIRE(second_finished == true);
+      }
+    }
+    release = true;
+  }
+}
+
+// =================================================================================================
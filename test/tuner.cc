@@ -36,6 +36,16 @@ __kernel void matvec_reference(const int kSizeM, const int kSizeN,
   }
   vec_y[get_global_id(0)] = result;
 })";
+const auto kernel3 = R"(
+__kernel void scale(const __global float* input, __global float* output) {
+  output[get_global_id(0)] = 2.0f * input[get_global_id(0)];
+})";
+const auto kernel4 = R"(
+__kernel void busy_scale(const __global float* input, __global float* output) {
+  float busy = input[get_global_id(0)];
+  for (int i=0; i<WORK; ++i) { busy = busy * 0.5f + 1.0f; }
+  output[get_global_id(0)] = (busy < 0.0f) ? 0.0f : 2.0f * input[get_global_id(0)];
+})";
 
 // =================================================================================================
 
@@ -114,3 +124,65 @@ SCENARIO("kernels can be added", "[Tuner]") {
 }
 
 // =================================================================================================
+
+SCENARIO("sweeps can be run over kernels with a reference", "[Tuner]") {
+  GIVEN("A kernel with a single configuration which is verified against a reference function") {
+    cltune::Tuner tuner(kPlatformID, kDeviceID);
+    tuner.SuppressOutput();
+    auto setup = [](cltune::Tuner &size_tuner, const size_t size) {
+      size_tuner.SuppressOutput();
+      auto id = size_tuner.AddKernelFromString(kernel3, "scale", {size}, {8});
+      size_tuner.AddParameter(id, "UNUSED", {1});
+      size_tuner.AddArgumentInput(id, std::vector<float>(size, 1.0f));
+      size_tuner.AddArgumentOutput(id, std::vector<float>(size, 0.0f));
+      size_tuner.SetReferenceFunction([size](const std::vector<void*> &outputs) {
+        auto output = static_cast<float*>(outputs[0]);
+        for (auto i = size_t{0}; i < size; ++i) { output[i] = 2.0f; }
+      });
+      return id;
+    };
+
+    WHEN("the sizes in between the smallest and the largest are confirmed with a single run") {
+      auto intervals = tuner.TuneSweep({64, 128, 192, 256}, setup);
+      THEN("their outputs are verified and they form a single interval") {
+        REQUIRE(intervals.size() == 1);
+        REQUIRE(intervals[0].configuration == cltune::ParameterRange({{"UNUSED", 1}}));
+      }
+    }
+  }
+}
+
+// =================================================================================================
+
+SCENARIO("relative time limits apply to results of which the verification is deferred", "[Tuner]") {
+  GIVEN("A fast and a much slower configuration, with deferred verification") {
+    cltune::Tuner tuner(kPlatformID, kDeviceID);
+    tuner.SuppressOutput();
+    const auto kSize = size_t{256};
+    auto id = tuner.AddKernelFromString(kernel4, "busy_scale", {kSize}, {8});
+    tuner.AddParameter(id, "WORK", {1, 1 << 24});
+    tuner.AddArgumentInput(id, std::vector<float>(kSize, 1.0f));
+    tuner.AddArgumentOutput(id, std::vector<float>(kSize, 0.0f));
+    tuner.SetReferenceFunction([kSize](const std::vector<void*> &outputs) {
+      auto output = static_cast<float*>(outputs[0]);
+      for (auto i = size_t{0}; i < kSize; ++i) { output[i] = 2.0f; }
+    });
+    tuner.ChooseVerificationMethod(cltune::VerificationMethod::AbsoluteDifference, 1e-4, 1, 0.0);
+    tuner.SetRelativeTimeout(2.0f);
+
+    WHEN("the fast configuration is measured first") {
+      auto results = tuner.TuneSingleKernel(id);
+      THEN("the slower configuration exceeds twice its time") {
+        auto slow_timed_out = false;
+        for (auto &result: results) {
+          if (result.parameter_values == cltune::ParameterRange({{"WORK", 1 << 24}})) {
+            slow_timed_out = (result.failure_reason == "timed out");
+          }
+        }
+        REQUIRE(slow_timed_out == true);
+      }
+    }
+  }
+}
+
+// =================================================================================================
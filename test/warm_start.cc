@@ -0,0 +1,63 @@
+
+// =================================================================================================
+// This file is part of the CLTune project, which loosely follows the Google C++ styleguide and uses
+// a tab-size of two spaces and a max-width of 100 characters per line.
+//
+// Author(s):
+//   agent <agent@local>
+//
+// This file tests the reader of previous tuning results for warm starts, using a results file in
+// the format of PrintJSON.
+//
+// =================================================================================================
+
+#include "catch.hpp"
+
+#include "internal/warm_start.h"
+
+#include <cstdio> // std::remove, fopen, fprintf
+#include <stdexcept> // std::runtime_error
+
+// Settings
+const std::string kResultsFile = "/tmp/cltune_warm_start_test.json";
+
+// =================================================================================================
+
+SCENARIO("previous results can be read as starting points", "[WarmStart]") {
+  GIVEN("A results file with results of two kernels and drift events") {
+    auto file = fopen(kResultsFile.c_str(), "w");
+    REQUIRE(file != nullptr);
+    fprintf(file, "{\n  \"device\": \"Device\",\n  \"drift_events\": [\n    {\"kernel\": \"gemm\", "
+                  "\"configuration\": 0, \"drift\": 1.200, \"remeasured\": 1}\n  ],\n"
+                  "  \"results\": [\n");
+    fprintf(file, "    {\n      \"kernel\": \"gemm\",\n      \"time\": 2.500,\n      \"timings\": "
+                  "{\"kernel\": 0.100, \"submitted\": 0.0, \"queued\": 0.0, \"wall_clock\": 0.0},"
+                  "\n      \"compile_time\": 0.100,\n"
+                  "      \"parameters\": {\"MWG\": 32,\"NWG\": 64}\n    },\n");
+    fprintf(file, "    {\n      \"kernel\": \"copy\",\n      \"time\": 0.500,\n"
+                  "      \"parameters\": {\"WPT\": 4}\n    },\n");
+    fprintf(file, "    {\n      \"kernel\": \"gemm\",\n      \"time\": 1.500,\n"
+                  "      \"parameters\": {\"MWG\": 16,\"NWG\": 128}\n    }\n  ]\n}\n");
+    fclose(file);
+
+    WHEN("the results of one kernel are read") {
+      auto configurations = cltune::ReadWarmStart(kResultsFile, "gemm");
+      THEN("only its configurations are returned, fastest first") {
+        REQUIRE(configurations.size() == 2);
+        REQUIRE(configurations[0] == cltune::ParameterRange({{"MWG", 16}, {"NWG", 128}}));
+        REQUIRE(configurations[1] == cltune::ParameterRange({{"MWG", 32}, {"NWG", 64}}));
+        REQUIRE(cltune::ReadWarmStart(kResultsFile, "other").empty());
+      }
+    }
+    WHEN("the file does not exist or is not a results file") {
+      THEN("reading it throws") {
+        REQUIRE_THROWS_AS(cltune::ReadWarmStart("/tmp/cltune_no_such_file.json", "gemm"),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(cltune::ReadWarmStart("/dev/null", "gemm"), std::runtime_error);
+      }
+    }
+    std::remove(kResultsFile.c_str());
+  }
+}
+
+// =================================================================================================